@@ -1,14 +1,15 @@
 #include "AdjacencyList.h"
+#include <limits>
 
 void AdjacencyList::display() {
 
 	std::cout << std::endl << "Graf w reprezentacji listowej: " << std::endl;
 
-	for (int i = 0; i < graph_order; i++) {
+	for (Index i = 0; i < graph_order; i++) {
 		std::cout << i;
 		ListNode* holder = adjList[i]->next;
 		while (holder != nullptr) {
-			std::cout << " ->" << pad(std::to_string(holder->id), 2) << ":" << pad(std::to_string(holder->weight), 3);
+			std::cout << " ->" << pad(std::to_string(holder->id), 2) << ":" << pad(formatNumber(holder->weight), 3);
 			holder = holder->next;
 		}
 		std::cout << std::endl;
@@ -30,7 +31,7 @@ std::string AdjacencyList::pad(std::string string, int length) {
 	return result;
 }
 
-void AdjacencyList::allocate(int order)
+void AdjacencyList::allocate(Index order)
 {
 	deallocate();
 
@@ -38,7 +39,7 @@ void AdjacencyList::allocate(int order)
 
 	adjList = new ListNode*[graph_order];
 
-	for (int i = 0; i < graph_order; i++) {
+	for (Index i = 0; i < graph_order; i++) {
 		adjList[i] = new ListNode;
 		adjList[i]->id = i;
 		adjList[i]->weight = 0;
@@ -48,7 +49,7 @@ void AdjacencyList::allocate(int order)
 void AdjacencyList::deallocate()
 {
 	ListNode* holder, * next_holder;
-	for (int i = 0; i < graph_order; i++) {		//delokacja list kolejnych wierzchokw
+	for (Index i = 0; i < graph_order; i++) {		//delokacja list kolejnych wierzchokw
 		holder = adjList[i];
 		while (holder->next != nullptr) {
 			next_holder = holder->next;
@@ -60,9 +61,10 @@ void AdjacencyList::deallocate()
 	delete[] adjList;						//delokacja tablicy
 
 	graph_order = 0;
+	arc_count = 0;
 }
 
-void AdjacencyList::addEdge(int v1, int v2, int value, bool directed) {
+void AdjacencyList::addEdge(Index v1, Index v2, Weight value, bool directed) {
 
 	//dla grafu skierowanego
 	ListNode* holder = adjList[v1];
@@ -74,6 +76,7 @@ void AdjacencyList::addEdge(int v1, int v2, int value, bool directed) {
 	holder->id = v2;				//ustawienie wartoci dla nowego elementu
 	holder->weight = value;
 	holder->next = nullptr;
+	arc_count++;
 
 	//analogicznie dla grafu nieskierowanego
 	if (!directed) {
@@ -86,136 +89,191 @@ void AdjacencyList::addEdge(int v1, int v2, int value, bool directed) {
 		holder->id = v1;		
 		holder->weight = value;
 		holder->next = nullptr;
+		arc_count++;
 	}
 }
 
+bool AdjacencyList::setWeight(Index v1, Index v2, Weight value, bool directed) {
+
+	bool found = false;
+	for (ListNode* holder = adjList[v1]->next; holder != nullptr; holder = holder->next) {
+		if (holder->id == v2) {
+			holder->weight = value;
+			found = true;
+			break;
+		}
+	}
+	if (found && !directed) {
+		for (ListNode* holder = adjList[v2]->next; holder != nullptr; holder = holder->next) {
+			if (holder->id == v1) {
+				holder->weight = value;
+				break;
+			}
+		}
+	}
+	return found;
+}
+
 List* AdjacencyList::mst_kruskal() {
+	Workspace ws;
+	mst_kruskal(ws);
+	return ws.treeToList();
+}
 
-	List* result = new List();
+List* AdjacencyList::mst_prim() {
+	Workspace ws;
+	mst_prim(ws);
+	return ws.treeToList();
+}
 
-	//utworzenie kolejki priorytetowej (kruskal, wic wszystkich) krawdzi
-	EdgeHeap* minEdgeHeap = new EdgeHeap();
-	Edge* e;
+PathResult* AdjacencyList::spp_dijkstra(Index vp) {
+	Workspace ws;
+	spp_dijkstra(vp, ws);
 
+	PathResult* result = new PathResult(graph_order, vp);
+	for (Index i = 0; i < graph_order; i++) {
+		result->distance[i] = ws.distance[i];
+		result->previous[i] = ws.previous[i];
+	}
+	return result;
+}
+
+void AdjacencyList::mst_kruskal(Workspace& ws) {
+
+	ws.prepare(graph_order, arc_count);
+
+	//utworzenie kolejki priorytetowej (kruskal, wic wszystkich) krawdzi
 	ListNode* holder;
-	for (int i = 0; i < graph_order; i++) {
+	for (Index i = 0; i < graph_order; i++) {
 		holder = adjList[i];
 		while (holder->next != nullptr) { 
 			holder = holder->next;
 			if (holder->id > i) {
-				e = new Edge;
-				e->v1 = i;
-				e->v2 = holder->id;
-				e->weight = holder->weight;
-				minEdgeHeap->push(e);
+				ws.edge_heap.push(Edge(i, holder->id, holder->weight));
 			}
 		}
 	}
 
-	DisjointSets* sets = new DisjointSets(graph_order);
-	while (minEdgeHeap->heap_length > 0) {
-		e = minEdgeHeap->pop();
-		if (!sets->isOneSet(e->v1, e->v2)) {
-			result->push(e);
-			sets->unionSets(e->v1, e->v2);
+	Edge e;
+	while (ws.edge_heap.heap_length > 0) {
+		e = ws.edge_heap.pop();
+		if (!ws.sets.isOneSet(e.v1, e.v2)) {
+			ws.addTreeEdge(e.v1, e.v2, e.weight);
+			ws.sets.unionSets(e.v1, e.v2);
 		}
 	}
-
-	return result;
 }
-List* AdjacencyList::mst_prim()
-{
-	List* result = new List();
 
-	bool* visited = new bool[graph_order] {false};
-	int visitedCount = 0;
+//wersja "zachlanna": kazdy wierzcholek spoza drzewa ma w kopcu jeden klucz - wage
+//najlzejszej krawedzi laczacej go z drzewem, wiec kopiec ma co najwyzej V elementow.
+//Gdy kopiec sie oprozni, a zostaly nieodwiedzone wierzcholki, budowane jest kolejne
+//drzewo - dla grafu niespojnego wynikiem jest minimalny las rozpinajacy.
+void AdjacencyList::mst_prim(Workspace& ws)
+{
+	mst_prim(ws, ws.vertex_heap);
+}
 
-	int currentNode = 0;
-	EdgeHeap* minEdgeHeap = new EdgeHeap();
+template <class Heap>
+void AdjacencyList::mst_prim(Workspace& ws, Heap& minKeyHeap)
+{
+	ws.prepare(graph_order, 0);
+	minKeyHeap.reserve(graph_order);
+
+	Distance* key = ws.distance;
+	Index* parent = ws.previous;
+	for (Index i = 0; i < graph_order; i++) {
+		key[i] = INFINITE_DISTANCE;
+		parent[i] = NO_INDEX;
+	}
 
-	visited[currentNode] = true;
-	visitedCount++;
+	ListNode* holder;
+	for (Index root = 0; root < graph_order; root++) {
+		if (ws.isVisited(root)) {
+			continue;
+		}
+		key[root] = 0;
+		minKeyHeap.push(root, 0);
+
+		while (!minKeyHeap.empty()) {
+			Index currentNode = minKeyHeap.pop();
+			ws.markVisited(currentNode);
+			if (parent[currentNode] != NO_INDEX) {
+				ws.addTreeEdge(parent[currentNode], currentNode, (Weight)key[currentNode]);
+			}
 
-	while (visitedCount < graph_order)
-	{
-		ListNode* holder = adjList[currentNode]->next;
-		while (holder != nullptr)
-		{
-			if (!visited[holder->id])
-			{
-				Edge* e = new Edge;
-				e->v1 = currentNode;
-				e->v2 = holder->id;
-				e->weight = holder->weight;
-				minEdgeHeap->push(e);
+			holder = adjList[currentNode]->next;
+			while (holder != nullptr) {
+				if (!ws.isVisited(holder->id) && holder->weight < key[holder->id]) {
+					key[holder->id] = holder->weight;
+					parent[holder->id] = currentNode;
+					if (minKeyHeap.contains(holder->id)) {
+						minKeyHeap.decreaseKey(holder->id, holder->weight);
+					}
+					else {
+						minKeyHeap.push(holder->id, holder->weight);
+					}
+				}
+				holder = holder->next;
 			}
-			holder = holder->next;
 		}
-
-		Edge* e;
-		do {
-			e = minEdgeHeap->pop();
-		} while (visited[e->v2]);
-
-		result->push(e);
-
-		currentNode = e->v2;
-		visited[currentNode] = true;
-		visitedCount++;
 	}
-
-	delete[] visited;
-	return result;
 }
 
 
-std::string AdjacencyList::spp_dijkstra(int vp, int vk)
+void AdjacencyList::spp_dijkstra(Index vp, Workspace& ws)
 {
-	VerticeHeap* minDistanceHeap = new VerticeHeap();
-	Vertice** vertice = new Vertice * [graph_order];	//tablica wskanikw pozwalajca zmienia wartoci w kopcu z O(1) - bez wyszukiwania odpowiedniego wierzchoka
+	spp_dijkstra(vp, ws, ws.vertex_heap);
+}
+
+template <class Heap>
+void AdjacencyList::spp_dijkstra(Index vp, Workspace& ws, Heap& minDistanceHeap)
+{
+	ws.prepare(graph_order, 0);
+	minDistanceHeap.reserve(graph_order);
 
-	Vertice* v;
-	for (int i = 0; i < graph_order; i++) {
-		v = new Vertice;
-		v->id = i;
-		v->previous = nullptr;
-		v->distance = i == vp ? 0 : 9999;	//odlego pocztkowego to 0, reszty "dua warto"
-		minDistanceHeap->push(v);
-		vertice[i] = v;		
+	for (Index i = 0; i < graph_order; i++) {
+		ws.distance[i] = i == vp ? 0 : INFINITE_DISTANCE;	//odleglosc poczatkowego to 0, reszty nieskonczona
+		ws.previous[i] = NO_INDEX;
 	}
 
-	ListNode* currentNode;
+	//w kopcu sa tylko wierzcholki z juz znana odlegloscia, a jej zmniejszenie
+	//przywraca wlasnosc kopca od razu (decreaseKey) - bez przebudowy calego kopca
+	minDistanceHeap.push(vp, 0);
+
 	ListNode* holder;
-	int old_dist, new_dist;
-	while (minDistanceHeap->heap_length > 0) {
-		v = minDistanceHeap->pop();	// pobranie wierzchoka o minimalnej wadze
-		currentNode = adjList[v->id];	// znalezienie wierzchoka w licie ssiedztwa
+	Index v;
+	Distance old_dist, new_dist;
+	while (!minDistanceHeap.empty()) {
+		v = minDistanceHeap.pop();	// pobranie wierzchoka o minimalnej wadze
 
 		//przejcie po wszystkich ssiadach v i ustalenie im odlegoci oraz poprzednika
-		holder = currentNode;
+		holder = adjList[v];
 		while (holder->next != nullptr) {
 			holder = holder->next;
-			
-			old_dist = vertice[holder->id]->distance;	//obecny dystans ssiada (id oznacza nr wierzchoka)
-			new_dist = v->distance + holder->weight; // odlego do v + odlego z v do rozpatrywanego ssiada
-			
+
+			old_dist = ws.distance[holder->id];
+			new_dist = ws.distance[v] + holder->weight;
+
 			if (new_dist < old_dist) {	//jeli nowa trasa jest krtsza nastpuje relaksacja
-				vertice[holder->id]->distance = new_dist;
-				vertice[holder->id]->previous = v;
+				ws.distance[holder->id] = new_dist;
+				ws.previous[holder->id] = v;
+				if (minDistanceHeap.contains(holder->id)) {
+					minDistanceHeap.decreaseKey(holder->id, new_dist);
+				}
+				else {
+					minDistanceHeap.push(holder->id, new_dist);
+				}
 			}
 		}
-		minDistanceHeap->heapifyDown(0);
 	}
-
-	v = vertice[vk];
-	std::string result;
-	do {
-		result = "[" + std::to_string(v->id) + "] " + result;
-		v = v->previous;
-	} while (v != nullptr);
-
-	v = vertice[vk];
-	result += "\n Calkowity koszt sciezki: " + std::to_string(v->distance);
-
-	return result;
 }
+
+//jawne konkretyzacje dla wszystkich kolejek priorytetowych wierzcholkow
+template void AdjacencyList::mst_prim<DaryHeap<2>>(Workspace& ws, DaryHeap<2>& heap);
+template void AdjacencyList::mst_prim<DaryHeap<4>>(Workspace& ws, DaryHeap<4>& heap);
+template void AdjacencyList::mst_prim<DaryHeap<8>>(Workspace& ws, DaryHeap<8>& heap);
+template void AdjacencyList::mst_prim<PairingHeap>(Workspace& ws, PairingHeap& heap);
+template void AdjacencyList::spp_dijkstra<DaryHeap<2>>(Index vp, Workspace& ws, DaryHeap<2>& heap);
+template void AdjacencyList::spp_dijkstra<DaryHeap<4>>(Index vp, Workspace& ws, DaryHeap<4>& heap);
+template void AdjacencyList::spp_dijkstra<DaryHeap<8>>(Index vp, Workspace& ws, DaryHeap<8>& heap);
+template void AdjacencyList::spp_dijkstra<PairingHeap>(Index vp, Workspace& ws, PairingHeap& heap);
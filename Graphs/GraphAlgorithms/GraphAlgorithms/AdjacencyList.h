@@ -5,7 +5,9 @@
 #include "EdgeHeap.h"
 #include "DisjointSets.h"
 #include "List.h"
-#include "VerticeHeap.h"
+#include "PathResult.h"
+#include "Workspace.h"
+#include "PairingHeap.h"
 
 class List;
 
@@ -13,13 +15,14 @@ class AdjacencyList
 {
 public:
 	struct ListNode {
-		int id;	//nr wierzchoka
-		int weight;		//waga krawdzi prowadzcej do tego wierzchoka 
+		Index id;	//nr wierzchoka
+		Weight weight;		//waga krawdzi prowadzcej do tego wierzchoka 
 		ListNode* next;
 	};
 
 	AdjacencyList() {
 		graph_order = 0;
+		arc_count = 0;
 		adjList = nullptr;
 	};
 
@@ -28,16 +31,30 @@ public:
 	};
 
 	void display();
-	void allocate(int order);
-	void addEdge(int v1, int v2, int weight, bool directed);
+	void allocate(Index order);
+	void addEdge(Index v1, Index v2, Weight weight, bool directed);
+	bool setWeight(Index v1, Index v2, Weight weight, bool directed);	//false - brak krawedzi
 
 	List* mst_kruskal();
 	List* mst_prim();
 
-	std::string spp_dijkstra(int vp, int vk);
+	PathResult* spp_dijkstra(Index vp);
+
+	//warianty korzystajace z przekazanej pamieci roboczej - wynik zostaje w ws
+	void mst_kruskal(Workspace& ws);
+	void mst_prim(Workspace& ws);
+	void spp_dijkstra(Index vp, Workspace& ws);
+
+	//Prim i Dijkstra nad dowolna kolejka priorytetowa wierzcholkow (DaryHeap<2/4/8>, PairingHeap)
+	template <class Heap> void mst_prim(Workspace& ws, Heap& heap);
+	template <class Heap> void spp_dijkstra(Index vp, Workspace& ws, Heap& heap);
+
+	Index getOrder() const { return graph_order; }
+	const ListNode* neighbours(Index v) const { return adjList[v]->next; }	//pierwszy sasiad wierzcholka v
 
 private:
-	int graph_order;
+	Index graph_order;
+	Index arc_count;	//liczba elementow wszystkich list (krawedz nieskierowana liczona dwa razy)
 	ListNode** adjList;
 
 	void deallocate();
@@ -0,0 +1,356 @@
+#include "AltShortestPaths.h"
+#include <algorithm>
+
+AltShortestPaths::AltShortestPaths(const AdjacencyList& list, bool directed, Index count,
+	Selection selection, int threads, unsigned seed)
+{
+	graph.build(list);
+	Index order = graph.getOrder();
+	landmark_count = std::min(count, order);
+	from_landmark = nullptr;
+	to_landmark = nullptr;
+	settled = 0;
+	last_target = NO_INDEX;
+
+	if (landmark_count > 0) {
+		BatchShortestPaths engine(list, threads);
+		std::mt19937 random(seed);
+		if (selection == Selection::Farthest) {
+			selectFarthest(engine, random);
+		}
+		else {
+			selectAvoid(engine, random);
+		}
+		computeTables(list, engine, directed, threads);
+	}
+
+	distance.assign(order, INFINITE_DISTANCE);
+	bound.assign(order, -1);
+	previous.assign(order, NO_INDEX);
+	heap.reserve(order);
+}
+
+AltShortestPaths::~AltShortestPaths()
+{
+	if (to_landmark != from_landmark) {
+		delete[] to_landmark;
+	}
+	delete[] from_landmark;
+}
+
+const char* AltShortestPaths::name(Selection selection)
+{
+	return selection == Selection::Farthest ? "farthest" : "avoid";
+}
+
+Index AltShortestPaths::randomVertex(std::mt19937& random) const
+{
+	return std::uniform_int_distribution<Index>(0, graph.getOrder() - 1)(random);
+}
+
+void AltShortestPaths::selectFarthest(BatchShortestPaths& engine, std::mt19937& random)
+{
+	Index order = graph.getOrder();
+
+	//pierwszy punkt - najdalszy osiagalny z losowego wierzcholka
+	Index start = randomVertex(random);
+	DistanceTable* table = engine.multiSource(&start, 1);
+	Index first = start;
+	for (Index v = 0; v < order; v++) {
+		Distance d = table->distance[v];
+		if (d < INFINITE_DISTANCE && d > table->distance[first]) {
+			first = v;
+		}
+	}
+	delete table;
+
+	//nearest[v] - odleglosc od najblizszego z wybranych punktow; wierzcholki nieosiagalne
+	//z zadnego (INFINITE_DISTANCE) ida na poczatek, co w grafie skierowanym pokrywa inne skladowe
+	std::vector<Distance> nearest(order, INFINITE_DISTANCE);
+	Index next = first;
+	while (true) {
+		landmarks.push_back(next);
+		if ((Index)landmarks.size() == landmark_count) {
+			break;
+		}
+
+		table = engine.multiSource(&next, 1);
+		for (Index v = 0; v < order; v++) {
+			nearest[v] = std::min(nearest[v], table->distance[v]);
+		}
+		delete table;
+
+		next = 0;
+		for (Index v = 1; v < order; v++) {
+			if (nearest[v] > nearest[next]) {
+				next = v;
+			}
+		}
+		if (nearest[next] == 0) {	//wszystkie wierzcholki sa juz punktami
+			break;
+		}
+	}
+	landmark_count = (Index)landmarks.size();
+}
+
+void AltShortestPaths::selectAvoid(BatchShortestPaths& engine, std::mt19937& random)
+{
+	Index order = graph.getOrder();
+
+	//pierwszy punkt jak w Farthest, kolejne z drzew o losowych korzeniach
+	Index start = randomVertex(random);
+	DistanceTable* table = engine.multiSource(&start, 1);
+	Index first = start;
+	for (Index v = 0; v < order; v++) {
+		Distance d = table->distance[v];
+		if (d < INFINITE_DISTANCE && d > table->distance[first]) {
+			first = v;
+		}
+	}
+	delete table;
+
+	std::vector<std::vector<Distance>> chosen;	//d(L, v) wybranych punktow
+	std::vector<char> is_landmark(order, 0);
+	std::vector<Distance> size(order);
+	std::vector<char> covered(order);
+	std::vector<Index> child_offset(order + 1);
+	std::vector<Index> children(order);
+	std::vector<Index> bfs(order);
+
+	Index next = first;
+	while (true) {
+		landmarks.push_back(next);
+		is_landmark[next] = 1;
+		table = engine.multiSource(&next, 1);
+		chosen.emplace_back(table->distance, table->distance + order);
+		delete table;
+		if ((Index)landmarks.size() == landmark_count) {
+			break;
+		}
+
+		Index root = randomVertex(random);
+		table = engine.multiSource(&root, 1);
+		const Distance* d = table->distance;
+		const Index* p = table->previous;
+
+		//dzieci w drzewie najkrotszych sciezek z root (CSR z tablicy poprzednikow)
+		std::fill(child_offset.begin(), child_offset.end(), 0);
+		for (Index v = 0; v < order; v++) {
+			if (p[v] != NO_INDEX) {
+				child_offset[p[v] + 1]++;
+			}
+		}
+		for (Index v = 0; v < order; v++) {
+			child_offset[v + 1] += child_offset[v];
+		}
+		std::vector<Index> pos(child_offset.begin(), child_offset.end() - 1);
+		for (Index v = 0; v < order; v++) {
+			if (p[v] != NO_INDEX) {
+				children[pos[p[v]]++] = v;
+			}
+		}
+
+		//kolejnosc BFS od korzenia, przetwarzana od konca - dzieci przed rodzicem
+		Index length = 0;
+		bfs[length++] = root;
+		for (Index i = 0; i < length; i++) {
+			Index u = bfs[i];
+			for (Index c = child_offset[u]; c < child_offset[u + 1]; c++) {
+				bfs[length++] = children[c];
+			}
+		}
+
+		//waga wierzcholka: o ile ograniczenie z dotychczasowych punktow jest za male;
+		//poddrzewo zawierajace punkt ma rozmiar 0 - tam ograniczenia juz sa dobre
+		for (Index i = length; i-- > 0;) {
+			Index v = bfs[i];
+			Distance lower = 0;
+			for (const std::vector<Distance>& from : chosen) {
+				if (from[v] < INFINITE_DISTANCE && from[root] < INFINITE_DISTANCE) {
+					lower = std::max(lower, from[v] - from[root]);
+				}
+			}
+			size[v] = d[v] - lower;
+			covered[v] = is_landmark[v];
+			for (Index c = child_offset[v]; c < child_offset[v + 1]; c++) {
+				size[v] += size[children[c]];
+				covered[v] |= covered[children[c]];
+			}
+			if (covered[v]) {
+				size[v] = 0;
+			}
+		}
+		delete table;
+
+		//zejscie od korzenia do najwiekszego poddrzewa az do liscia
+		next = root;
+		if (size[root] > 0) {
+			while (true) {
+				Index best = NO_INDEX;
+				for (Index c = child_offset[next]; c < child_offset[next + 1]; c++) {
+					Index v = children[c];
+					if (size[v] > 0 && (best == NO_INDEX || size[v] > size[best])) {
+						best = v;
+					}
+				}
+				if (best == NO_INDEX) {
+					break;
+				}
+				next = best;
+			}
+		}
+		if (is_landmark[next]) {
+			//drzewo w calosci pokryte - dowolny wolny wierzcholek
+			if ((Index)landmarks.size() == order) {
+				break;
+			}
+			do {
+				next = randomVertex(random);
+			} while (is_landmark[next]);
+		}
+	}
+	landmark_count = (Index)landmarks.size();
+}
+
+void AltShortestPaths::computeTables(const AdjacencyList& list, BatchShortestPaths& engine, bool directed, int threads)
+{
+	Index order = graph.getOrder();
+	size_t cells = (size_t)order * landmark_count;
+
+	//wiersz tablicy to punkt, a w silniku potrzebny jest wierzcholek - uklad [v][i], zeby
+	//potencjal wierzcholka czytal jeden spojny kawalek pamieci
+	auto transpose = [&](const DistanceTable* table, Distance* target) {
+		for (Index i = 0; i < landmark_count; i++) {
+			const Distance* row = table->distanceRow(i);
+			for (Index v = 0; v < order; v++) {
+				target[(size_t)v * landmark_count + i] = row[v];
+			}
+		}
+	};
+
+	DistanceTable* table = engine.multiSource(landmarks.data(), landmark_count);
+	from_landmark = new Distance[cells];
+	transpose(table, from_landmark);
+	delete table;
+
+	if (!directed) {
+		to_landmark = from_landmark;
+		return;
+	}
+	BatchShortestPaths reverse(list, threads, true);
+	table = reverse.multiSource(landmarks.data(), landmark_count);
+	to_landmark = new Distance[cells];
+	transpose(table, to_landmark);
+	delete table;
+}
+
+size_t AltShortestPaths::memoryBytes() const
+{
+	size_t cells = (size_t)graph.getOrder() * landmark_count;
+	size_t tables = cells * sizeof(Distance) * (to_landmark != from_landmark ? 2 : 1);
+	return tables + (graph.getOrder() + 1) * sizeof(Index)
+		+ graph.getArcCount() * (sizeof(Index) + sizeof(Weight));
+}
+
+//najwieksze ograniczenie dolne d(v, target); INFINITE_DISTANCE, gdy z v nie da sie dojsc do celu
+Distance AltShortestPaths::potential(Index v, Index target) const
+{
+	const Distance* from_v = from_landmark + (size_t)v * landmark_count;
+	const Distance* from_t = from_landmark + (size_t)target * landmark_count;
+	const Distance* to_v = to_landmark + (size_t)v * landmark_count;
+	const Distance* to_t = to_landmark + (size_t)target * landmark_count;
+
+	Distance best = 0;
+	for (Index i = 0; i < landmark_count; i++) {
+		if (from_v[i] < INFINITE_DISTANCE) {
+			if (from_t[i] >= INFINITE_DISTANCE) {
+				return INFINITE_DISTANCE;	//L dochodzi do v, a do celu nie
+			}
+			best = std::max(best, from_t[i] - from_v[i]);
+		}
+		if (to_t[i] < INFINITE_DISTANCE) {
+			if (to_v[i] >= INFINITE_DISTANCE) {
+				return INFINITE_DISTANCE;	//z celu da sie dojsc do L, a z v nie
+			}
+			best = std::max(best, to_v[i] - to_t[i]);
+		}
+	}
+	return best;
+}
+
+Distance AltShortestPaths::query(Index source, Index target)
+{
+	for (Index v : touched) {
+		distance[v] = INFINITE_DISTANCE;
+		bound[v] = -1;
+		previous[v] = NO_INDEX;
+	}
+	touched.clear();
+	heap.clear();
+	settled = 0;
+	last_target = target;
+
+	distance[source] = 0;
+	bound[source] = landmark_count > 0 ? potential(source, target) : 0;
+	touched.push_back(source);
+	if (bound[source] >= INFINITE_DISTANCE) {
+		return INFINITE_DISTANCE;
+	}
+	heap.push(source, bound[source]);
+
+	while (!heap.empty()) {
+		Index u = heap.pop();
+		settled++;
+		if (u == target) {
+			return distance[u];
+		}
+		Distance du = distance[u];
+
+		for (Index a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+			Index v = graph.target[a];
+			Distance new_dist = du + graph.weight[a];
+			if (new_dist >= distance[v]) {
+				continue;
+			}
+			if (bound[v] < 0) {
+				bound[v] = landmark_count > 0 ? potential(v, target) : 0;
+				touched.push_back(v);
+			}
+			if (bound[v] >= INFINITE_DISTANCE) {
+				continue;	//wierzcholek nie prowadzi do celu
+			}
+			distance[v] = new_dist;
+			previous[v] = u;
+			//potencjal jest spojny, wiec kazdy wierzcholek zdejmowany jest co najwyzej raz
+			if (heap.contains(v)) {
+				heap.decreaseKey(v, new_dist + bound[v]);
+			}
+			else {
+				heap.push(v, new_dist + bound[v]);
+			}
+		}
+	}
+	return INFINITE_DISTANCE;
+}
+
+Index AltShortestPaths::pathLength() const
+{
+	if (last_target == NO_INDEX || distance[last_target] >= INFINITE_DISTANCE) {
+		return 0;
+	}
+	Index length = 0;
+	for (Index v = last_target; v != NO_INDEX; v = previous[v]) {
+		length++;
+	}
+	return length;
+}
+
+void AltShortestPaths::extractPath(Index* path) const
+{
+	Index length = pathLength();
+	Index v = last_target;
+	for (Index i = length; i-- > 0;) {
+		path[i] = v;
+		v = previous[v];
+	}
+}
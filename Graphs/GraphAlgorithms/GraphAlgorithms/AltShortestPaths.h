@@ -0,0 +1,75 @@
+#pragma once
+
+#include <random>
+#include <vector>
+#include "AdjacencyList.h"
+#include "BatchShortestPaths.h"
+#include "CompactGraph.h"
+#include "IndexedHeap.h"
+
+// Zapytania punkt-punkt algorytmem ALT (A*, Landmarks, nierownosc trojkata).
+// Przy budowie wybieranych jest k wierzcholkow-punktow orientacyjnych L i dla kazdego
+// wierzcholka v zapamietywane sa d(L, v) oraz d(v, L). Z nierownosci trojkata
+//   d(v, t) >= d(L, t) - d(L, v)   oraz   d(v, t) >= d(v, L) - d(t, L),
+// a najwieksze z tych ograniczen jest potencjalem A* prowadzacym przeszukiwanie w strone
+// celu - zdejmowane sa glownie wierzcholki lezace "po drodze", a nie cala kula wokol zrodla.
+// Wybor punktow:
+//   - Farthest: kazdy kolejny jest najdalszy od juz wybranych,
+//   - Avoid (Goldberg, Werneck): w drzewie najkrotszych sciezek z losowego korzenia szukane jest
+//     poddrzewo, dla ktorego dotychczasowe ograniczenia sa najslabsze; punktem zostaje jego lisc.
+// Wybor wymaga kolejnych, zaleznych od siebie Dijkstr; tablice odleglosci liczone sa potem
+// rownolegle silnikiem BatchShortestPaths (od punktow na grafie, do punktow na grafie odwroconym).
+// Numeracja wierzcholkow jak w liscie, z ktorej zbudowano silnik.
+class AltShortestPaths
+{
+public:
+	enum class Selection { Farthest, Avoid };
+
+	//directed = false - lista zawiera oba luki kazdej krawedzi, wiec d(L, v) = d(v, L)
+	//i druga tablica nie jest potrzebna
+	AltShortestPaths(const AdjacencyList& list, bool directed, Index count,
+		Selection selection = Selection::Avoid, int threads = 0, unsigned seed = 1);
+	~AltShortestPaths();
+
+	AltShortestPaths(const AltShortestPaths&) = delete;
+	AltShortestPaths& operator=(const AltShortestPaths&) = delete;
+
+	//odleglosc source -> target (INFINITE_DISTANCE, gdy brak sciezki)
+	Distance query(Index source, Index target);
+
+	//sciezka ostatniego zapytania (od zrodla do celu) - jak PathResult::pathLength/extractPath
+	Index pathLength() const;
+	void extractPath(Index* path) const;
+
+	Index lastSettled() const { return settled; }	//wierzcholki zdjete w ostatnim zapytaniu
+	Index getLandmarkCount() const { return landmark_count; }
+	const Index* getLandmarks() const { return landmarks.data(); }
+	size_t memoryBytes() const;	//tablice punktow orientacyjnych i graf zwarty
+
+	static const char* name(Selection selection);
+
+private:
+	CompactGraph graph;
+	Index landmark_count;
+	std::vector<Index> landmarks;
+
+	//odleglosci wierzcholka v od/do kolejnych punktow: [v * landmark_count + i];
+	//dla grafu nieskierowanego to_landmark wskazuje na from_landmark
+	Distance* from_landmark;
+	Distance* to_landmark;
+
+	//stan zapytania - czyszczone sa tylko wierzcholki dotkniete poprzednim zapytaniem
+	std::vector<Distance> distance;
+	std::vector<Distance> bound;	//potencjal wierzcholka liczony przy pierwszym dotknieciu, -1 - jeszcze nie
+	std::vector<Index> previous;
+	std::vector<Index> touched;
+	IndexedHeap heap;
+	Index settled;
+	Index last_target;
+
+	Index randomVertex(std::mt19937& random) const;
+	void selectFarthest(BatchShortestPaths& engine, std::mt19937& random);
+	void selectAvoid(BatchShortestPaths& engine, std::mt19937& random);
+	void computeTables(const AdjacencyList& list, BatchShortestPaths& engine, bool directed, int threads);
+	Distance potential(Index v, Index target) const;
+};
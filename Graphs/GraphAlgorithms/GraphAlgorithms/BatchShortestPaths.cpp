@@ -0,0 +1,255 @@
+#include "BatchShortestPaths.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+BatchShortestPaths::BatchShortestPaths(const AdjacencyList& list, int threads, bool reverse)
+{
+	graph.build(list, reverse);
+
+	thread_count = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+	if (thread_count < 1) {
+		thread_count = 1;
+	}
+
+	scratch = new IndexedHeap[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		scratch[i].reserve(graph.getOrder());
+	}
+}
+
+BatchShortestPaths::~BatchShortestPaths()
+{
+	delete[] scratch;
+}
+
+DistanceTable* BatchShortestPaths::multiSource(const Index* sources, Index count)
+{
+	DistanceTable* table = new DistanceTable(count, graph.getOrder());
+	std::copy(sources, sources + count, table->sources);
+
+	//zrodla rozdzielane sa dynamicznie - watek bierze kolejne, gdy skonczy poprzednie
+	std::atomic<Index> next(0);
+	auto worker = [&](int t) {
+		for (Index r = next++; r < count; r = next++) {
+			dijkstra(table->sources[r], table->distanceRow(r), table->previousRow(r), scratch[t]);
+		}
+	};
+
+	int workers = (int)std::min<Index>(thread_count, count);
+	std::vector<std::thread> pool;
+	for (int t = 1; t < workers; t++) {
+		pool.emplace_back(worker, t);
+	}
+	worker(0);
+	for (std::thread& th : pool) {
+		th.join();
+	}
+
+	return table;
+}
+
+Index BatchShortestPaths::answerQueries(const PathQuery* queries, Index count, const GroupSink& sink)
+{
+	//numery zapytan posortowane wedlug zrodla - kazda grupa to spojny przedzial
+	std::vector<Index> sorted(count);
+	for (Index q = 0; q < count; q++) {
+		sorted[q] = q;
+	}
+	std::stable_sort(sorted.begin(), sorted.end(), [queries](Index a, Index b) {
+		return queries[a].source < queries[b].source;
+	});
+	std::vector<Index> groupStart;
+	for (Index q = 0; q < count; q++) {
+		if (q == 0 || queries[sorted[q]].source != queries[sorted[q - 1]].source) {
+			groupStart.push_back(q);
+		}
+	}
+	Index groups = (Index)groupStart.size();
+	groupStart.push_back(count);
+
+	//tablice odleglosci i poprzednikow - jedna para na watek, uzywana dla kolejnych grup
+	Index order = graph.getOrder();
+	int workers = (int)std::min<Index>(thread_count, groups);
+	std::vector<Distance> distance((size_t)workers * order);
+	std::vector<Index> previous((size_t)workers * order);
+
+	std::atomic<Index> next(0);
+	auto worker = [&](int t) {
+		Distance* d = distance.data() + (size_t)t * order;
+		Index* p = previous.data() + (size_t)t * order;
+		for (Index g = next++; g < groups; g = next++) {
+			const Index* group = sorted.data() + groupStart[g];
+			dijkstra(queries[group[0]].source, d, p, scratch[t]);
+			sink(group, groupStart[g + 1] - groupStart[g], d, p);
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (int t = 1; t < workers; t++) {
+		pool.emplace_back(worker, t);
+	}
+	if (workers > 0) {
+		worker(0);
+	}
+	for (std::thread& th : pool) {
+		th.join();
+	}
+	return groups;
+}
+
+DistanceTable* BatchShortestPaths::allPairs(Mode mode)
+{
+	if (mode == Mode::FloydWarshall || (mode == Mode::Auto && preferFloydWarshall())) {
+		return floydWarshall();
+	}
+
+	Index order = graph.getOrder();
+	Index* sources = new Index[order];
+	for (Index v = 0; v < order; v++) {
+		sources[v] = v;
+	}
+	DistanceTable* table = multiSource(sources, order);
+	delete[] sources;
+	return table;
+}
+
+bool BatchShortestPaths::preferFloydWarshall() const
+{
+	//dla gestych, niewielkich grafow n^3 prostych, zwektoryzowanych operacji
+	//wygrywa z n uruchomieniami Dijkstry pelnymi skokow po kopcu
+	double order = graph.getOrder();
+	return order <= FW_MAX_ORDER && (double)graph.getArcCount() * 8 >= order * order;
+}
+
+void BatchShortestPaths::dijkstra(Index source, Distance* distance, Index* previous, IndexedHeap& heap) const
+{
+	Index order = graph.getOrder();
+	for (Index v = 0; v < order; v++) {
+		distance[v] = INFINITE_DISTANCE;
+		previous[v] = NO_INDEX;
+	}
+
+	heap.clear();
+	distance[source] = 0;
+	heap.push(source, 0);
+
+	while (!heap.empty()) {
+		Index u = heap.pop();
+		Distance du = distance[u];
+
+		//relaksacja lukow wychodzacych z u
+		for (Index a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+			Index v = graph.target[a];
+			Distance new_dist = du + graph.weight[a];
+			if (new_dist < distance[v]) {
+				distance[v] = new_dist;
+				previous[v] = u;
+				if (heap.contains(v)) {
+					heap.decreaseKey(v, new_dist);
+				}
+				else {
+					heap.push(v, new_dist);
+				}
+			}
+		}
+	}
+}
+
+DistanceTable* BatchShortestPaths::floydWarshall()
+{
+	Index order = graph.getOrder();
+	DistanceTable* table = new DistanceTable(order, order);
+
+	for (Index i = 0; i < order; i++) {
+		table->sources[i] = i;
+		Distance* d = table->distanceRow(i);
+		Index* p = table->previousRow(i);
+		for (Index j = 0; j < order; j++) {
+			d[j] = INFINITE_DISTANCE;
+			p[j] = NO_INDEX;
+		}
+		d[i] = 0;
+		//przy krawedziach wielokrotnych liczy sie najlzejsza
+		for (Index a = graph.offset[i]; a < graph.offset[i + 1]; a++) {
+			Index j = graph.target[a];
+			if (j != i && graph.weight[a] < d[j]) {
+				d[j] = graph.weight[a];
+				p[j] = i;
+			}
+		}
+	}
+
+	Index blocks = (order + FW_BLOCK - 1) / FW_BLOCK;
+	int workers = (int)std::min<Index>(thread_count, blocks);
+
+	for (Index k = 0; k < blocks; k++) {
+		//faza 1 - blok na przekatnej
+		relaxBlock(table, k, k, k);
+
+		//faza 2 - bloki w wierszu i kolumnie k, zalezne tylko od bloku przekatnej
+		for (Index b = 0; b < blocks; b++) {
+			if (b != k) {
+				relaxBlock(table, k, b, k);
+				relaxBlock(table, b, k, k);
+			}
+		}
+
+		//faza 3 - pozostale bloki sa od siebie niezalezne, wiersze blokow dzielone miedzy watki
+		std::atomic<Index> next(0);
+		auto worker = [&]() {
+			for (Index i = next++; i < blocks; i = next++) {
+				if (i == k) {
+					continue;
+				}
+				for (Index j = 0; j < blocks; j++) {
+					if (j != k) {
+						relaxBlock(table, i, j, k);
+					}
+				}
+			}
+		};
+
+		std::vector<std::thread> pool;
+		for (int t = 1; t < workers; t++) {
+			pool.emplace_back(worker);
+		}
+		worker();
+		for (std::thread& th : pool) {
+			th.join();
+		}
+	}
+
+	return table;
+}
+
+void BatchShortestPaths::relaxBlock(DistanceTable* table, Index bi, Index bj, Index bk) const
+{
+	Index order = table->order;
+	Index i_end = std::min<Index>((bi + 1) * FW_BLOCK, order);
+	Index j_begin = bj * FW_BLOCK;
+	Index j_end = std::min<Index>((bj + 1) * FW_BLOCK, order);
+	Index k_end = std::min<Index>((bk + 1) * FW_BLOCK, order);
+
+	for (Index k = bk * FW_BLOCK; k < k_end; k++) {
+		const Distance* dk = table->distanceRow(k);
+		const Index* pk = table->previousRow(k);
+		for (Index i = bi * FW_BLOCK; i < i_end; i++) {
+			Distance* di = table->distanceRow(i);
+			Index* pi = table->previousRow(i);
+			Distance dik = di[k];
+			if (dik >= INFINITE_DISTANCE) {
+				continue;
+			}
+			//petla bez rozgalezien - kompilator zamienia ja na porownania i mieszanie wektorowe;
+			//INFINITE_DISTANCE to polowa zakresu typu Distance, wiec suma nie przepelnia sie
+			for (Index j = j_begin; j < j_end; j++) {
+				Distance through_k = dik + dk[j];
+				bool better = through_k < di[j];
+				di[j] = better ? through_k : di[j];
+				pi[j] = better ? pk[j] : pi[j];
+			}
+		}
+	}
+}
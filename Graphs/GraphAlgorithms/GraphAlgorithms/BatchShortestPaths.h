@@ -0,0 +1,81 @@
+#pragma once
+
+#include "AdjacencyList.h"
+#include "CompactGraph.h"
+#include "IndexedHeap.h"
+#include <functional>
+
+// Wynik zapytania wsadowego: wiersz r odpowiada zrodlu sources[r],
+// kolumna v - wierzcholkowi v. Poprzednik NO_INDEX oznacza zrodlo lub brak sciezki,
+// a odleglosc INFINITE_DISTANCE - brak sciezki.
+struct DistanceTable
+{
+	DistanceTable(Index rows, Index order) : rows(rows), order(order) {
+		sources = new Index[rows];
+		distance = new Distance[(size_t)rows * order];
+		previous = new Index[(size_t)rows * order];
+	};
+
+	~DistanceTable() {
+		delete[] sources;
+		delete[] distance;
+		delete[] previous;
+	};
+
+	DistanceTable(const DistanceTable&) = delete;
+	DistanceTable& operator=(const DistanceTable&) = delete;
+
+	Distance* distanceRow(Index r) const { return distance + (size_t)r * order; }
+	Index* previousRow(Index r) const { return previous + (size_t)r * order; }
+
+	Index rows;
+	Index order;
+	Index* sources;
+	Distance* distance;
+	Index* previous;
+};
+
+// Zapytanie punkt-punkt w numeracji grafu, z ktorego zbudowano silnik
+struct PathQuery
+{
+	Index source;
+	Index target;
+};
+
+// Silnik najkrotszych sciezek z wielu zrodel na jednym grafie.
+// Graf kopiowany jest raz do postaci zwartej, a kazdy watek ma wlasny kopiec,
+// ktory zachowywany jest pomiedzy kolejnymi zapytaniami.
+class BatchShortestPaths
+{
+public:
+	enum class Mode { Auto, Dijkstra, FloydWarshall };
+
+	//reverse - silnik na grafie odwroconym: odleglosci do zrodel zamiast od zrodel
+	BatchShortestPaths(const AdjacencyList& list, int threads = 0, bool reverse = false);
+	~BatchShortestPaths();
+
+	DistanceTable* multiSource(const Index* sources, Index count);
+	DistanceTable* allPairs(Mode mode = Mode::Auto);
+
+	//zapytania grupowane wedlug zrodla - jeden Dijkstra na grupe, grupy liczone rownolegle.
+	//sink wywolywany jest z watkow roboczych (wspolbieznie) raz na grupe: numery zapytan grupy
+	//oraz odleglosci i poprzednicy ze wspolnego zrodla, wazne tylko na czas wywolania.
+	//Zwraca liczbe grup (roznych zrodel).
+	typedef std::function<void(const Index* group, Index length, const Distance* distance, const Index* previous)> GroupSink;
+	Index answerQueries(const PathQuery* queries, Index count, const GroupSink& sink);
+
+	int getThreads() const { return thread_count; }
+
+private:
+	static const int FW_BLOCK = 64;		//bok bloku macierzy w algorytmie Floyda-Warshalla
+	static const Index FW_MAX_ORDER = 4096;	//powyzej macierz n x n przestaje byc oplacalna
+
+	CompactGraph graph;
+	IndexedHeap* scratch;	//jeden kopiec na watek
+	int thread_count;
+
+	void dijkstra(Index source, Distance* distance, Index* previous, IndexedHeap& heap) const;
+	DistanceTable* floydWarshall();
+	void relaxBlock(DistanceTable* table, Index bi, Index bj, Index bk) const;
+	bool preferFloydWarshall() const;
+};
@@ -0,0 +1,84 @@
+#include "CompactGraph.h"
+#include <algorithm>
+
+void CompactGraph::build(const AdjacencyList& list, bool reverse)
+{
+	deallocate();
+
+	graph_order = list.getOrder();
+	offset = new Index[graph_order + 1];
+
+	if (reverse) {
+		buildReverse(list);
+		return;
+	}
+
+	//pierwsze przejscie - zliczenie lukow wychodzacych z kazdego wierzcholka
+	offset[0] = 0;
+	for (Index v = 0; v < graph_order; v++) {
+		Index degree = 0;
+		for (const AdjacencyList::ListNode* holder = list.neighbours(v); holder != nullptr; holder = holder->next) {
+			degree++;
+		}
+		offset[v + 1] = offset[v] + degree;
+	}
+	arc_count = offset[graph_order];
+
+	target = new Index[arc_count];
+	weight = new Weight[arc_count];
+
+	//drugie przejscie - przepisanie lukow w kolejnosci list
+	for (Index v = 0; v < graph_order; v++) {
+		Index pos = offset[v];
+		for (const AdjacencyList::ListNode* holder = list.neighbours(v); holder != nullptr; holder = holder->next) {
+			target[pos] = holder->id;
+			weight[pos] = holder->weight;
+			pos++;
+		}
+	}
+}
+
+void CompactGraph::buildReverse(const AdjacencyList& list)
+{
+	//zliczenie lukow wchodzacych - offset[v + 1] to na razie stopien wejsciowy v
+	for (Index v = 0; v <= graph_order; v++) {
+		offset[v] = 0;
+	}
+	for (Index v = 0; v < graph_order; v++) {
+		for (const AdjacencyList::ListNode* holder = list.neighbours(v); holder != nullptr; holder = holder->next) {
+			offset[holder->id + 1]++;
+		}
+	}
+	for (Index v = 0; v < graph_order; v++) {
+		offset[v + 1] += offset[v];
+	}
+	arc_count = offset[graph_order];
+
+	target = new Index[arc_count];
+	weight = new Weight[arc_count];
+
+	//luk v -> u trafia na kolejne wolne miejsce w przedziale u
+	Index* pos = new Index[graph_order];
+	std::copy(offset, offset + graph_order, pos);
+	for (Index v = 0; v < graph_order; v++) {
+		for (const AdjacencyList::ListNode* holder = list.neighbours(v); holder != nullptr; holder = holder->next) {
+			Index a = pos[holder->id]++;
+			target[a] = v;
+			weight[a] = holder->weight;
+		}
+	}
+	delete[] pos;
+}
+
+void CompactGraph::deallocate()
+{
+	delete[] offset;
+	delete[] target;
+	delete[] weight;
+	offset = nullptr;
+	target = nullptr;
+	weight = nullptr;
+
+	graph_order = 0;
+	arc_count = 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "AdjacencyList.h"
+
+// Zwarta (CSR / "forward star") kopia listy sasiedztwa: sasiedzi wierzcholka v
+// zajmuja w tablicach target/weight przedzial [offset[v], offset[v + 1]).
+// Budowana raz, a nastepnie czytana przez silniki wykonujace wiele zapytan.
+// Z reverse = true powstaje graf odwrocony (luk u -> v zapisany jako v -> u) -
+// Dijkstra na nim liczy odleglosci do zrodla zamiast od zrodla.
+class CompactGraph
+{
+public:
+	CompactGraph() {
+		graph_order = 0;
+		arc_count = 0;
+		offset = nullptr;
+		target = nullptr;
+		weight = nullptr;
+	};
+
+	~CompactGraph() {
+		deallocate();
+	};
+
+	void build(const AdjacencyList& list, bool reverse = false);
+
+	Index getOrder() const { return graph_order; }
+	Index getArcCount() const { return arc_count; }
+
+	Index* offset;	//graph_order + 1 elementow
+	Index* target;
+	Weight* weight;	//przy wadze uint8 czterokrotnie mniej pamieci do przeczytania niz int
+
+private:
+	Index graph_order;
+	Index arc_count;
+
+	void buildReverse(const AdjacencyList& list);
+	void deallocate();
+};
@@ -0,0 +1,342 @@
+#include "ContractionHierarchy.h"
+#include <algorithm>
+
+namespace
+{
+	//fragment sciezki do rozwiniecia - luk grafu (middle == NO_INDEX) albo skrot
+	struct Segment {
+		Index from;
+		Index to;
+		Index middle;
+	};
+
+	template <typename ArcType>
+	void removeArc(std::vector<ArcType>& arcs, Index target)
+	{
+		for (size_t i = 0; i < arcs.size(); i++) {
+			if (arcs[i].target == target) {
+				arcs[i] = arcs.back();
+				arcs.pop_back();
+				return;
+			}
+		}
+	}
+}
+
+ContractionHierarchy::ContractionHierarchy(const AdjacencyList& list)
+{
+	Index order = list.getOrder();
+	shortcut_count = 0;
+	settled = 0;
+	meeting = NO_INDEX;
+
+	out.assign(order, std::vector<Arc>());
+	in.assign(order, std::vector<Arc>());
+	for (Index u = 0; u < order; u++) {
+		for (const AdjacencyList::ListNode* node = list.neighbours(u); node != nullptr; node = node->next) {
+			if (node->id != u) {	//petla nie lezy na zadnej najkrotszej sciezce
+				addArc(u, node->id, node->weight, NO_INDEX);
+			}
+		}
+	}
+	witness.assign(order, INFINITE_DISTANCE);
+	witness_heap.reserve(order);
+
+	//priorytet: roznica krawedzi plus liczba sciagnietych sasiadow
+	std::vector<Index> contracted_neighbours(order, 0);
+	auto evaluate = [&](Index v) {
+		return (Distance)contract(v, true) - (Distance)(in[v].size() + out[v].size()) + (Distance)contracted_neighbours[v];
+	};
+
+	IndexedHeap queue;
+	queue.reserve(order);
+	for (Index v = 0; v < order; v++) {
+		queue.push(v, evaluate(v));
+	}
+
+	std::vector<std::vector<Arc>> up_forward(order);
+	std::vector<std::vector<Arc>> up_backward(order);
+	std::vector<Index> neighbours;
+	rank.assign(order, NO_INDEX);
+	Index next_rank = 0;
+	while (!queue.empty()) {
+		Index v = queue.pop();
+
+		//priorytety w kopcu sa nieaktualne po sciaganiu sasiadow - liczone od nowa dopiero
+		//przy zdjeciu (leniwie), a wierzcholek, ktory przestal byc najlepszy, wraca do kopca;
+		//przeliczanie wszystkich sasiadow po kazdym sciagnieciu kosztowalo kilka razy wiecej
+		Distance current = evaluate(v);
+		if (!queue.empty() && current > queue.topKey()) {
+			queue.push(v, current);
+			continue;
+		}
+
+		rank[v] = next_rank++;
+		shortcut_count += contract(v, false);
+
+		//pozostale luki v prowadza do wierzcholkow sciaganych pozniej - to graf gorny v
+		neighbours.clear();
+		for (const Arc& arc : out[v]) {
+			neighbours.push_back(arc.target);
+			removeArc(in[arc.target], v);
+		}
+		for (const Arc& arc : in[v]) {
+			neighbours.push_back(arc.target);
+			removeArc(out[arc.target], v);
+		}
+		up_forward[v].swap(out[v]);
+		up_backward[v].swap(in[v]);
+
+		std::sort(neighbours.begin(), neighbours.end());
+		neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+		for (Index n : neighbours) {
+			contracted_neighbours[n]++;
+		}
+	}
+
+	buildUpward(forward, up_forward);
+	buildUpward(backward, up_backward);
+
+	//struktury budowy nie sa juz potrzebne
+	std::vector<std::vector<Arc>>().swap(out);
+	std::vector<std::vector<Arc>>().swap(in);
+	std::vector<Distance>().swap(witness);
+	std::vector<Index>().swap(witness_touched);
+
+	for (int side = 0; side < 2; side++) {
+		distance[side].assign(order, INFINITE_DISTANCE);
+		parent[side].assign(order, NO_INDEX);
+		parent_middle[side].assign(order, NO_INDEX);
+		heap[side].reserve(order);
+	}
+}
+
+//luk u -> x; przy istniejacym luku zostaje lzejszy
+void ContractionHierarchy::addArc(Index u, Index x, Distance weight, Index middle)
+{
+	for (Arc& arc : out[u]) {
+		if (arc.target == x) {
+			if (weight < arc.weight) {
+				arc.weight = weight;
+				arc.middle = middle;
+				for (Arc& back : in[x]) {
+					if (back.target == u) {
+						back.weight = weight;
+						back.middle = middle;
+						break;
+					}
+				}
+			}
+			return;
+		}
+	}
+	out[u].push_back({ x, middle, weight });
+	in[x].push_back({ u, middle, weight });
+}
+
+//Dijkstra z u w biezacym grafie z pominieciem skip, do odleglosci limit lub WITNESS_SETTLE_LIMIT
+//zdjetych wierzcholkow; przerwane przeszukiwanie daje gorne ograniczenia, wiec co najwyzej
+//powstaja zbedne (ale poprawne) skroty
+void ContractionHierarchy::witnessSearch(Index u, Index skip, Distance limit)
+{
+	for (Index w : witness_touched) {
+		witness[w] = INFINITE_DISTANCE;
+	}
+	witness_touched.clear();
+	witness_heap.clear();
+
+	witness[u] = 0;
+	witness_touched.push_back(u);
+	witness_heap.push(u, 0);
+
+	Index count = 0;
+	while (!witness_heap.empty() && witness_heap.topKey() <= limit && count++ < WITNESS_SETTLE_LIMIT) {
+		Index y = witness_heap.pop();
+		Distance dy = witness[y];
+		for (const Arc& arc : out[y]) {
+			if (arc.target == skip) {
+				continue;
+			}
+			Distance new_dist = dy + arc.weight;
+			if (new_dist < witness[arc.target]) {
+				if (witness[arc.target] >= INFINITE_DISTANCE) {
+					witness_touched.push_back(arc.target);
+				}
+				witness[arc.target] = new_dist;
+				if (witness_heap.contains(arc.target)) {
+					witness_heap.decreaseKey(arc.target, new_dist);
+				}
+				else {
+					witness_heap.push(arc.target, new_dist);
+				}
+			}
+		}
+	}
+}
+
+//liczba skrotow potrzebnych po sciagnieciu v; simulate = false - skroty sa dodawane
+Index ContractionHierarchy::contract(Index v, bool simulate)
+{
+	Index shortcuts = 0;
+	for (size_t i = 0; i < in[v].size(); i++) {
+		Index u = in[v][i].target;
+		Distance to_v = in[v][i].weight;
+
+		Distance limit = -1;
+		for (const Arc& arc : out[v]) {
+			if (arc.target != u) {
+				limit = std::max(limit, to_v + arc.weight);
+			}
+		}
+		if (limit < 0) {
+			continue;
+		}
+		witnessSearch(u, v, limit);
+
+		for (size_t j = 0; j < out[v].size(); j++) {
+			Index x = out[v][j].target;
+			Distance via = to_v + out[v][j].weight;
+			if (x == u || witness[x] <= via) {
+				continue;
+			}
+			shortcuts++;
+			if (!simulate) {
+				addArc(u, x, via, v);
+			}
+		}
+	}
+	return shortcuts;
+}
+
+void ContractionHierarchy::buildUpward(UpwardGraph& graph, std::vector<std::vector<Arc>>& arcs)
+{
+	Index order = (Index)arcs.size();
+	graph.offset.assign(order + 1, 0);
+	for (Index v = 0; v < order; v++) {
+		graph.offset[v + 1] = graph.offset[v] + (Index)arcs[v].size();
+	}
+	graph.arcs.clear();
+	graph.arcs.reserve(graph.offset[order]);
+	for (Index v = 0; v < order; v++) {
+		graph.arcs.insert(graph.arcs.end(), arcs[v].begin(), arcs[v].end());
+		std::vector<Arc>().swap(arcs[v]);
+	}
+}
+
+size_t ContractionHierarchy::memoryBytes() const
+{
+	return rank.size() * sizeof(Index)
+		+ (forward.offset.size() + backward.offset.size()) * sizeof(Index)
+		+ (forward.arcs.size() + backward.arcs.size()) * sizeof(Arc);
+}
+
+Distance ContractionHierarchy::query(Index source, Index target)
+{
+	for (Index v : touched) {
+		for (int side = 0; side < 2; side++) {
+			distance[side][v] = INFINITE_DISTANCE;
+			parent[side][v] = NO_INDEX;
+		}
+	}
+	touched.clear();
+	heap[0].clear();
+	heap[1].clear();
+	settled = 0;
+	meeting = NO_INDEX;
+
+	distance[0][source] = 0;
+	distance[1][target] = 0;
+	touched.push_back(source);
+	touched.push_back(target);
+	heap[0].push(source, 0);
+	heap[1].push(target, 0);
+
+	//strona z mniejszym kluczem na szczycie; strona konczy, gdy jej klucz dojdzie do best -
+	//dalej w gore hierarchii nic krotszego juz nie ma
+	Distance best = INFINITE_DISTANCE;
+	while (!heap[0].empty() || !heap[1].empty()) {
+		int side = heap[1].empty() || (!heap[0].empty() && heap[0].topKey() <= heap[1].topKey()) ? 0 : 1;
+		if (heap[side].topKey() >= best) {
+			heap[side].clear();
+			continue;
+		}
+
+		Index u = heap[side].pop();
+		settled++;
+		Distance du = distance[side][u];
+		if (distance[1 - side][u] < INFINITE_DISTANCE && du + distance[1 - side][u] < best) {
+			best = du + distance[1 - side][u];
+			meeting = u;
+		}
+
+		const UpwardGraph& graph = side == 0 ? forward : backward;
+		for (Index a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+			const Arc& arc = graph.arcs[a];
+			Distance new_dist = du + arc.weight;
+			if (new_dist < distance[side][arc.target]) {
+				if (distance[side][arc.target] >= INFINITE_DISTANCE) {
+					touched.push_back(arc.target);
+				}
+				distance[side][arc.target] = new_dist;
+				parent[side][arc.target] = u;
+				parent_middle[side][arc.target] = arc.middle;
+				if (heap[side].contains(arc.target)) {
+					heap[side].decreaseKey(arc.target, new_dist);
+				}
+				else {
+					heap[side].push(arc.target, new_dist);
+				}
+			}
+		}
+	}
+	return best;
+}
+
+const ContractionHierarchy::Arc* ContractionHierarchy::findArc(const UpwardGraph& graph, Index u, Index target) const
+{
+	for (Index a = graph.offset[u]; a < graph.offset[u + 1]; a++) {
+		if (graph.arcs[a].target == target) {
+			return &graph.arcs[a];
+		}
+	}
+	return nullptr;
+}
+
+void ContractionHierarchy::extractPath(std::vector<Index>& path) const
+{
+	path.clear();
+	if (meeting == NO_INDEX) {
+		return;
+	}
+
+	//luki gornych drzew: od zrodla do wierzcholka spotkania i od niego do celu
+	std::vector<Segment> segments;
+	for (Index v = meeting; parent[0][v] != NO_INDEX; v = parent[0][v]) {
+		segments.push_back({ parent[0][v], v, parent_middle[0][v] });
+	}
+	std::reverse(segments.begin(), segments.end());
+	for (Index v = meeting; parent[1][v] != NO_INDEX; v = parent[1][v]) {
+		segments.push_back({ v, parent[1][v], parent_middle[1][v] });
+	}
+
+	path.push_back(segments.empty() ? meeting : segments[0].from);
+
+	//skrot from -> to przez middle to luki from -> middle (wchodzacy do middle, w grafie backward)
+	//i middle -> to (wychodzacy z middle, w grafie forward) - middle ma nizsza range niz oba konce
+	std::vector<Segment> stack;
+	for (const Segment& segment : segments) {
+		stack.push_back(segment);
+		while (!stack.empty()) {
+			Segment s = stack.back();
+			stack.pop_back();
+			if (s.middle == NO_INDEX) {
+				path.push_back(s.to);
+				continue;
+			}
+			const Arc* second = findArc(forward, s.middle, s.to);
+			const Arc* first = findArc(backward, s.middle, s.from);
+			stack.push_back({ s.middle, s.to, second->middle });
+			stack.push_back({ s.from, s.middle, first->middle });
+		}
+	}
+}
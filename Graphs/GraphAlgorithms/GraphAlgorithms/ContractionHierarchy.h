@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include "AdjacencyList.h"
+#include "IndexedHeap.h"
+
+// Hierarchia skrotow (contraction hierarchies) dla wielu zapytan punkt-punkt na stalym grafie.
+// Przy budowie wierzcholki sa po kolei "sciagane" z grafu: dla kazdej pary luku wchodzacego
+// u -> v i wychodzacego v -> x, jesli u -> v -> x jest jedyna najkrotsza droga (lokalne
+// przeszukiwanie z u z pominieciem v nie znajduje swiadka), dodawany jest skrot u -> x.
+// Kolejnosc wybierana jest wedlug priorytetu: roznica krawedzi (skroty do dodania minus
+// usuwane luki) plus liczba juz sciagnietych sasiadow, co rozklada sciaganie po grafie.
+// Zapytanie to dwukierunkowy Dijkstra chodzacy tylko "w gore" hierarchii - od zrodla lukami do
+// wierzcholkow sciagnietych pozniej, od celu lukami z takich wierzcholkow - wiec przeszukuje
+// niewielka czesc grafu. Skroty rozwijane sa z powrotem do lukow grafu przy odtwarzaniu sciezki.
+// Numeracja wierzcholkow jak w liscie, z ktorej zbudowano hierarchie.
+class ContractionHierarchy
+{
+public:
+	ContractionHierarchy(const AdjacencyList& list);
+
+	//odleglosc source -> target (INFINITE_DISTANCE, gdy brak sciezki)
+	Distance query(Index source, Index target);
+
+	//sciezka ostatniego zapytania od zrodla do celu, ze skrotami rozwinietymi do lukow grafu;
+	//pusta, gdy brak sciezki
+	void extractPath(std::vector<Index>& path) const;
+
+	Index lastSettled() const { return settled; }	//wierzcholki zdjete w ostatnim zapytaniu (obie strony)
+	Index getShortcutCount() const { return shortcut_count; }
+	Index getUpwardArcCount() const { return (Index)(forward.arcs.size() + backward.arcs.size()); }
+	Index rankOf(Index v) const { return rank[v]; }	//pozycja v w kolejnosci sciagania
+	size_t memoryBytes() const;	//graf gorny obu kierunkow i rangi
+
+private:
+	//luk grafu lub skrot (middle - wierzcholek, przez ktory prowadzi skrot, NO_INDEX dla luku grafu);
+	//suma wag moze nie miescic sie w Weight, wiec waga skrotu jest typu Distance
+	struct Arc {
+		Index target;
+		Index middle;
+		Distance weight;
+	};
+
+	//luki do wierzcholkow o wyzszej randze: forward - wychodzace (u -> target),
+	//backward - wchodzace (target -> u); Arc z przedzialu [offset[u], offset[u + 1])
+	struct UpwardGraph {
+		std::vector<Index> offset;
+		std::vector<Arc> arcs;
+	};
+
+	static const Index WITNESS_SETTLE_LIMIT = 64;	//wieksze - mniej zbednych skrotow, dluzsza budowa
+
+	std::vector<Index> rank;
+	UpwardGraph forward;
+	UpwardGraph backward;
+	Index shortcut_count;
+
+	//stan zapytania - czyszczone sa tylko wierzcholki dotkniete poprzednim zapytaniem
+	std::vector<Distance> distance[2];	//0 - od zrodla, 1 - do celu
+	std::vector<Index> parent[2];	//poprzedni wierzcholek na stronie
+	std::vector<Index> parent_middle[2];	//middle luku, ktorym wierzcholek zostal osiagniety
+	std::vector<Index> touched;
+	IndexedHeap heap[2];
+	Index settled;
+	Index meeting;
+
+	//budowa: biezacy graf z lukami w obie strony (in[x] - luki wchodzace, target to ich poczatek)
+	std::vector<std::vector<Arc>> out;
+	std::vector<std::vector<Arc>> in;
+	std::vector<Distance> witness;
+	std::vector<Index> witness_touched;
+	IndexedHeap witness_heap;
+
+	void addArc(Index u, Index x, Distance weight, Index middle);
+	void witnessSearch(Index u, Index skip, Distance limit);
+	Index contract(Index v, bool simulate);
+	void buildUpward(UpwardGraph& graph, std::vector<std::vector<Arc>>& arcs);
+	const Arc* findArc(const UpwardGraph& graph, Index u, Index target) const;
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "GraphTypes.h"
+
+// Indeksowany kopiec D-arny (D = 2, 4, 8) z operacja zmniejszenia klucza.
+// Tablica position pamieta miejsce kazdego wierzcholka w kopcu (NO_INDEX gdy go nie ma),
+// dzieci wezla i to D*i + 1 ... D*i + D. Wieksze D oznacza plytszy kopiec i dzieci
+// lezace obok siebie w pamieci, kosztem wiekszej liczby porownan przy zdejmowaniu.
+//
+// Wspolny interfejs kolejek priorytetowych wierzcholkow (DaryHeap, PairingHeap):
+// reserve, clear, push, pop, decreaseKey, contains, empty, topKey.
+template <int D>
+class DaryHeap
+{
+public:
+	static_assert(D >= 2, "kopiec musi miec co najmniej dwoje dzieci");
+
+	DaryHeap() {
+		heap_length = 0;
+		capacity = 0;
+		entries = nullptr;
+		position = nullptr;
+	};
+
+	~DaryHeap() {
+		delete[] entries;
+		delete[] position;
+	};
+
+	DaryHeap(const DaryHeap&) = delete;
+	DaryHeap& operator=(const DaryHeap&) = delete;
+
+	//pamiec alokowana jest tylko gdy graf jest wiekszy niz poprzednio
+	void reserve(Index order) {
+		if (order > capacity) {
+			delete[] entries;
+			delete[] position;
+
+			capacity = order;
+			entries = new Entry[capacity];
+			position = new Index[capacity];
+			for (Index i = 0; i < capacity; i++) {
+				position[i] = NO_INDEX;
+			}
+			heap_length = 0;
+			return;
+		}
+		clear();
+	}
+
+	void clear() {
+		//wystarczy wyczyscic pozycje wierzcholkow, ktore zostaly w kopcu
+		for (Index i = 0; i < heap_length; i++) {
+			position[entries[i].id] = NO_INDEX;
+		}
+		heap_length = 0;
+	}
+
+	void push(Index v, Distance key) {
+		entries[heap_length].key = key;
+		entries[heap_length].id = v;
+		position[v] = heap_length;
+		heap_length++;
+
+		heapifyUp(heap_length - 1);
+	}
+
+	//usuwanie korzenia kopca, zwraca numer wierzcholka
+	Index pop() {
+		Index v = entries[0].id;
+		position[v] = NO_INDEX;
+
+		heap_length--;
+		if (heap_length > 0) {
+			entries[0] = entries[heap_length];
+			position[entries[0].id] = 0;
+			heapifyDown(0);
+		}
+		return v;
+	}
+
+	void decreaseKey(Index v, Distance key) {
+		Index i = position[v];
+		entries[i].key = key;
+		heapifyUp(i);
+	}
+
+	bool contains(Index v) const { return position[v] != NO_INDEX; }
+	bool empty() const { return heap_length == 0; }
+	Distance topKey() const { return entries[0].key; }
+
+	Index heap_length;
+
+private:
+	struct Entry {
+		Distance key;
+		Index id;
+	};
+
+	Entry* entries;
+	Index* position;
+	Index capacity;
+
+	void heapifyUp(Index i) {
+		Entry moved = entries[i];
+
+		//przesuwanie rodzicow w dol zamiast zamiany par elementow
+		while (i > 0) {
+			Index parent = (i - 1) / D;
+			if (entries[parent].key <= moved.key) {
+				break;
+			}
+			entries[i] = entries[parent];
+			position[entries[i].id] = i;
+			i = parent;
+		}
+		entries[i] = moved;
+		position[moved.id] = i;
+	}
+
+	void heapifyDown(Index i) {
+		Entry moved = entries[i];
+
+		while (true) {
+			Index first = D * i + 1;
+			if (first >= heap_length) {
+				break;
+			}
+			Index last = first + D < heap_length ? first + D : heap_length;
+
+			//najmniejsze z co najwyzej D dzieci
+			Index smallest = first;
+			for (Index c = first + 1; c < last; c++) {
+				if (entries[c].key < entries[smallest].key) {
+					smallest = c;
+				}
+			}
+			if (moved.key <= entries[smallest].key) {
+				break;
+			}
+			entries[i] = entries[smallest];
+			position[entries[i].id] = i;
+			i = smallest;
+		}
+		entries[i] = moved;
+		position[moved.id] = i;
+	}
+};
@@ -1,12 +1,28 @@
 #include "DisjointSets.h"
 
-void DisjointSets::makeOwnSet(int x)
+void DisjointSets::reset(Index n)
+{
+	if (n > capacity) {
+		delete[] parent;
+		delete[] rank;
+		capacity = n;
+		parent = new Index[capacity];
+		rank = new Index[capacity];
+	}
+
+	set_size = n;
+	for (Index i = 0; i < set_size; i++) {
+		makeOwnSet(i);
+	}
+}
+
+void DisjointSets::makeOwnSet(Index x)
 {
 	parent[x] = x;
 	rank[x] = 1;
 }
 
-int DisjointSets::findSetRoot(int x)
+Index DisjointSets::findSetRoot(Index x)
 {
 	//gdy zbir nie pochodzi od tego wierchoka
 	if (x != parent[x]) {
@@ -18,10 +34,10 @@ int DisjointSets::findSetRoot(int x)
 	return parent[x];
 }
 
-void DisjointSets::unionSets(int x, int y) 
+void DisjointSets::unionSets(Index x, Index y) 
 {
-	int setX = findSetRoot(x);	//x
-	int setY = findSetRoot(y);	//x
+	Index setX = findSetRoot(x);	//x
+	Index setY = findSetRoot(y);	//x
 
 	if(setX == setY) {	//elementy nale do jednego zbioru
 		return;
@@ -39,7 +55,7 @@ void DisjointSets::unionSets(int x, int y)
 	}
 }
 
-bool DisjointSets::isOneSet(int x, int y)
+bool DisjointSets::isOneSet(Index x, Index y)
 {
 	return findSetRoot(x) == findSetRoot(y);
 }
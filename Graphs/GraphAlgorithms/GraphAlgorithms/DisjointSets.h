@@ -1,15 +1,19 @@
 #pragma once
+
+#include "GraphTypes.h"
+
 class DisjointSets
 {
 public:
-	DisjointSets(int n) {
-		set_size = n;
-		parent = new int[set_size];
-		rank = new int[set_size];
-
-		for (int i = 0; i < set_size; i++) {
-			makeOwnSet(i);
-		}
+	DisjointSets() {
+		set_size = 0;
+		capacity = 0;
+		parent = nullptr;
+		rank = nullptr;
+	};
+
+	DisjointSets(Index n) : DisjointSets() {
+		reset(n);
 	};
 
 	~DisjointSets() {
@@ -17,16 +21,19 @@ public:
 		delete[] rank;
 	};
 
-	bool isOneSet(int x, int y);
-	void unionSets(int x, int y);
+	void reset(Index n);	//n jednoelementowych zbiorow, tablice alokowane tylko gdy sa za male
+
+	bool isOneSet(Index x, Index y);
+	void unionSets(Index x, Index y);
 
 private:
 	//zbiory rozpoznawane s przez wierzchoek, od ktrego si zacz dany zbir (root)
-	int* parent;	//zbir do ktrego naley wierzchoek
-	int* rank;		//wielko zbioru w ktrym si znajduje wierzchoek
-	int set_size;
+	Index* parent;	//zbir do ktrego naley wierzchoek
+	Index* rank;		//wielko zbioru w ktrym si znajduje wierzchoek
+	Index set_size;
+	Index capacity;
 
-	void makeOwnSet(int x);
-	int findSetRoot(int x);
+	void makeOwnSet(Index x);
+	Index findSetRoot(Index x);
 };
 
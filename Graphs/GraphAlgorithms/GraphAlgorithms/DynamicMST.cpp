@@ -0,0 +1,180 @@
+#include "DynamicMST.h"
+#include <algorithm>
+
+DynamicMST::DynamicMST()
+{
+	total_weight = 0;
+	edge_count = 0;
+	stamp = 0;
+}
+
+void DynamicMST::build(Graph& graph)
+{
+	Index order = graph.getOrder();
+	tree.assign(order, std::vector<TreeArc>());
+	parent.assign(order, NO_INDEX);
+	parent_weight.assign(order, 0);
+	mark.assign(order, 0);
+	stamp = 0;
+	total_weight = 0;
+	edge_count = 0;
+
+	graph.mst_kruskal_list(ws);
+	for (Index i = 0; i < ws.tree_length; i++) {
+		link(ws.tree[i].v1, ws.tree[i].v2, ws.tree[i].weight);
+	}
+}
+
+void DynamicMST::link(Index v1, Index v2, Weight weight)
+{
+	tree[v1].push_back({ v2, weight });
+	tree[v2].push_back({ v1, weight });
+	total_weight += weight;
+	edge_count++;
+}
+
+void DynamicMST::cut(Index v1, Index v2)
+{
+	for (int side = 0; side < 2; side++) {
+		std::vector<TreeArc>& arcs = tree[side == 0 ? v1 : v2];
+		Index other = side == 0 ? v2 : v1;
+		for (size_t i = 0; i < arcs.size(); i++) {
+			if (arcs[i].to == other) {
+				if (side == 0) {
+					total_weight -= arcs[i].weight;
+				}
+				arcs[i] = arcs.back();
+				arcs.pop_back();
+				break;
+			}
+		}
+	}
+	edge_count--;
+}
+
+DynamicMST::TreeArc* DynamicMST::treeArc(Index v1, Index v2)
+{
+	for (TreeArc& arc : tree[v1]) {
+		if (arc.to == v2) {
+			return &arc;
+		}
+	}
+	return nullptr;
+}
+
+unsigned DynamicMST::nextStamp()
+{
+	if (++stamp == 0) {	//po przepelnieniu licznik zaczyna od nowa na czystej tablicy
+		std::fill(mark.begin(), mark.end(), 0);
+		stamp = 1;
+	}
+	return stamp;
+}
+
+//DFS po drzewie z from; true, gdy to lezy w tej samej skladowej - wtedy parent
+//i parent_weight opisuja sciezke od to z powrotem do from
+bool DynamicMST::findPath(Index from, Index to)
+{
+	unsigned current = nextStamp();
+	stack.clear();
+	stack.push_back(from);
+	mark[from] = current;
+	parent[from] = NO_INDEX;
+	while (!stack.empty()) {
+		Index u = stack.back();
+		stack.pop_back();
+		if (u == to) {
+			return true;
+		}
+		for (const TreeArc& arc : tree[u]) {
+			if (mark[arc.to] != current) {
+				mark[arc.to] = current;
+				parent[arc.to] = u;
+				parent_weight[arc.to] = arc.weight;
+				stack.push_back(arc.to);
+			}
+		}
+	}
+	return false;
+}
+
+//krawedz spoza lasu kandydatem do lasu - wlasnosc cyklu
+void DynamicMST::addCandidate(Index v1, Index v2, Weight weight)
+{
+	if (v1 == v2) {
+		return;
+	}
+	if (!findPath(v1, v2)) {	//rozne skladowe - krawedz je laczy
+		link(v1, v2, weight);
+		return;
+	}
+
+	//najciezsza krawedz na sciezce v2 -> v1
+	Index heaviest = v2;
+	for (Index v = v2; parent[v] != NO_INDEX; v = parent[v]) {
+		if (parent_weight[v] > parent_weight[heaviest]) {
+			heaviest = v;
+		}
+	}
+	if (weight < parent_weight[heaviest]) {
+		cut(heaviest, parent[heaviest]);
+		link(v1, v2, weight);
+	}
+}
+
+//po usunieciu krawedzi drzewa v1-v2: najlzejsza krawedz grafu laczaca obie czesci
+void DynamicMST::reconnect(const Graph& graph, Index v1)
+{
+	//czesc z v1 oznaczona przez findPath (drugi koniec jest juz poza nia)
+	findPath(v1, NO_INDEX);
+	unsigned side = stamp;
+
+	const AdjacencyList& list = *graph.list_rep;
+	Index bestFrom = NO_INDEX, bestTo = NO_INDEX;
+	Weight best = 0;
+	for (Index u = 0; u < (Index)mark.size(); u++) {
+		if (mark[u] != side) {
+			continue;
+		}
+		for (const AdjacencyList::ListNode* node = list.neighbours(u); node != nullptr; node = node->next) {
+			if (mark[node->id] != side && (bestFrom == NO_INDEX || node->weight < best)) {
+				bestFrom = u;
+				bestTo = node->id;
+				best = node->weight;
+			}
+		}
+	}
+	if (bestFrom != NO_INDEX) {
+		link(bestFrom, bestTo, best);
+	}
+}
+
+void DynamicMST::insertEdge(Graph& graph, Index v1, Index v2, Weight weight)
+{
+	graph.insertEdge(v1, v2, weight);
+	addCandidate(graph.toInternal(v1), graph.toInternal(v2), weight);
+}
+
+bool DynamicMST::changeWeight(Graph& graph, Index v1, Index v2, Weight weight)
+{
+	if (!graph.setEdgeWeight(v1, v2, weight)) {
+		return false;
+	}
+	Index u = graph.toInternal(v1);
+	Index v = graph.toInternal(v2);
+
+	TreeArc* arc = treeArc(u, v);
+	if (arc == nullptr) {
+		addCandidate(u, v, weight);	//lzejsza moze wejsc do drzewa, ciezsza niczego nie zmienia
+		return true;
+	}
+	if (weight <= arc->weight) {
+		total_weight -= arc->weight - weight;
+		arc->weight = weight;
+		treeArc(v, u)->weight = weight;
+		return true;
+	}
+	cut(u, v);
+	reconnect(graph, u);
+	return true;
+}
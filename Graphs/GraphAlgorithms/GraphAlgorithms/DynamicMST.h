@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include "Graph.h"
+#include "Workspace.h"
+
+// Minimalny las rozpinajacy grafu nieskierowanego utrzymywany przy zmianach grafu,
+// bez ponownego uruchamiania Kruskala. Metody zmieniaja graf (Graph::insertEdge,
+// Graph::setEdgeWeight) i poprawiaja las:
+//   - nowa krawedz lub krawedz spoza drzewa, ktora stala sie lzejsza: sciezka w drzewie
+//     pomiedzy jej koncami i wlasnosc cyklu - najciezsza krawedz cyklu wypada, O(V),
+//   - krawedz drzewa, ktora stala sie lzejsza: tylko zmiana wagi, O(stopien w drzewie),
+//   - krawedz drzewa, ktora stala sie ciezsza: drzewo rozcinane na dwie czesci i laczone
+//     najlzejsza krawedzia przekroju (wlasnosc przekroju), O(V + krawedzie jednej czesci),
+//   - krawedz spoza drzewa, ktora stala sie ciezsza: bez zmian.
+// Las przechowywany jest w numeracji wewnetrznej grafu.
+class DynamicMST
+{
+public:
+	DynamicMST();
+
+	//las od nowa (Kruskal na liscie sasiedztwa)
+	void build(Graph& graph);
+
+	//numery oryginalne; changeWeight zwraca false, gdy krawedzi nie ma
+	void insertEdge(Graph& graph, Index v1, Index v2, Weight weight);
+	bool changeWeight(Graph& graph, Index v1, Index v2, Weight weight);
+
+	Distance weight() const { return total_weight; }
+	Index edgeCount() const { return edge_count; }
+
+private:
+	struct TreeArc {
+		Index to;
+		Weight weight;
+	};
+
+	std::vector<std::vector<TreeArc>> tree;
+	Distance total_weight;
+	Index edge_count;
+	Workspace ws;
+
+	//robocze tablice przeszukiwania drzewa; stamp zamiast czyszczenia calych tablic
+	std::vector<Index> parent;
+	std::vector<Weight> parent_weight;
+	std::vector<unsigned> mark;
+	unsigned stamp;
+	std::vector<Index> stack;
+
+	void link(Index v1, Index v2, Weight weight);
+	void cut(Index v1, Index v2);
+	TreeArc* treeArc(Index v1, Index v2);
+	unsigned nextStamp();
+	bool findPath(Index from, Index to);
+	void addCandidate(Index v1, Index v2, Weight weight);
+	void reconnect(const Graph& graph, Index v1);
+};
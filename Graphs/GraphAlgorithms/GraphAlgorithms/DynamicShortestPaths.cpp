@@ -0,0 +1,115 @@
+#include "DynamicShortestPaths.h"
+
+DynamicShortestPaths::DynamicShortestPaths()
+{
+	source = NO_INDEX;
+	needs_full = false;
+}
+
+void DynamicShortestPaths::compute(Graph& graph, Index vp)
+{
+	source = graph.toInternal(vp);
+	Index order = graph.getOrder();
+	distance.assign(order, INFINITE_DISTANCE);
+	previous.assign(order, NO_INDEX);
+	heap.reserve(order);
+	heap.clear();
+
+	distance[source] = 0;
+	heap.push(source, 0);
+	dijkstra(graph);
+
+	pending.clear();
+	needs_full = false;
+}
+
+void DynamicShortestPaths::relax(Index u, Index v, Weight weight)
+{
+	Distance new_dist = distance[u] + weight;
+	if (new_dist < distance[v]) {
+		distance[v] = new_dist;
+		previous[v] = u;
+		if (heap.contains(v)) {
+			heap.decreaseKey(v, new_dist);
+		}
+		else {
+			heap.push(v, new_dist);
+		}
+	}
+}
+
+//Dijkstra od wierzcholkow juz lezacych w kopcu, z biezacymi odleglosciami jako ograniczeniami -
+//wierzcholek trafia do kopca tylko wtedy, gdy jego odleglosc maleje; zwraca liczbe zdjetych
+Index DynamicShortestPaths::dijkstra(const Graph& graph)
+{
+	Index settled = 0;
+	while (!heap.empty()) {
+		Index u = heap.pop();
+		settled++;
+		for (const AdjacencyList::ListNode* node = graph.list_rep->neighbours(u); node != nullptr; node = node->next) {
+			relax(u, node->id, node->weight);
+		}
+	}
+	return settled;
+}
+
+void DynamicShortestPaths::addPending(const Graph& graph, Index v1, Index v2, Weight weight)
+{
+	Index u = graph.toInternal(v1);
+	Index v = graph.toInternal(v2);
+	pending.push_back({ u, v, weight });
+	if (!graph.isDirected()) {
+		pending.push_back({ v, u, weight });
+	}
+}
+
+void DynamicShortestPaths::insertEdge(Graph& graph, Index v1, Index v2, Weight weight)
+{
+	graph.insertEdge(v1, v2, weight);
+	addPending(graph, v1, v2, weight);
+}
+
+bool DynamicShortestPaths::changeWeight(Graph& graph, Index v1, Index v2, Weight weight)
+{
+	Weight old;
+	if (!graph.getEdgeWeight(v1, v2, old) || !graph.setEdgeWeight(v1, v2, weight)) {
+		return false;
+	}
+	if (weight > old) {
+		needs_full = true;
+	}
+	else if (weight < old) {
+		addPending(graph, v1, v2, weight);
+	}
+	return true;
+}
+
+Index DynamicShortestPaths::update(Graph& graph)
+{
+	if (needs_full || distance.size() != graph.getOrder()) {
+		compute(graph, graph.toOriginal(source));
+		return graph.getOrder();
+	}
+
+	//nowe lub lzejsze luki sa jedynym miejscem, w ktorym odleglosci moga zmalec
+	heap.clear();
+	for (const PendingArc& arc : pending) {
+		if (distance[arc.from] < INFINITE_DISTANCE) {
+			relax(arc.from, arc.to, arc.weight);
+		}
+	}
+	pending.clear();
+	return dijkstra(graph);
+}
+
+PathResult* DynamicShortestPaths::toPathResult(const Graph& graph) const
+{
+	Index order = (Index)distance.size();
+	PathResult* result = new PathResult(order, graph.toOriginal(source));
+	for (Index v = 0; v < order; v++) {
+		Index u = graph.toOriginal(v);
+		result->distance[u] = distance[v];
+		result->previous[u] = previous[v] == NO_INDEX ? NO_INDEX : graph.toOriginal(previous[v]);
+	}
+	return result;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include "Graph.h"
+#include "IndexedHeap.h"
+#include "PathResult.h"
+
+// Najkrotsze sciezki z jednego zrodla utrzymywane przy zmianach grafu. Po pelnym
+// Dijkstrze (compute) zachowane sa odleglosci i poprzednicy; krawedzie dodane lub
+// zlzejsze (insertEdge, changeWeight) zapamietywane sa jako luki do sprawdzenia, a update()
+// relaksuje je i prowadzi Dijkstre tylko od wierzcholkow, ktorych odleglosc zmalala -
+// reszta drzewa pozostaje nietknieta. Wzrost wagi moze wydluzyc dowolna sciezke
+// w poddrzewie, wiec po nim update() liczy wszystko od nowa.
+// Tablice przechowywane sa w numeracji wewnetrznej grafu.
+class DynamicShortestPaths
+{
+public:
+	DynamicShortestPaths();
+
+	void compute(Graph& graph, Index vp);
+
+	//numery oryginalne; zmieniaja graf od razu, drzewo dopiero w update()
+	void insertEdge(Graph& graph, Index v1, Index v2, Weight weight);
+	bool changeWeight(Graph& graph, Index v1, Index v2, Weight weight);	//false - brak krawedzi
+
+	//doprowadza drzewo do zgodnosci z grafem; zwraca liczbe wierzcholkow, ktorych odleglosc
+	//zostala poprawiona (przy pelnym przeliczeniu - wszystkie)
+	Index update(Graph& graph);
+
+	Distance distanceTo(const Graph& graph, Index v) const { return distance[graph.toInternal(v)]; }
+	PathResult* toPathResult(const Graph& graph) const;	//kopia w numeracji oryginalnej
+
+	const Distance* getDistances() const { return distance.data(); }	//numeracja wewnetrzna
+	Index getSource() const { return source; }
+
+private:
+	struct PendingArc {
+		Index from;
+		Index to;
+		Weight weight;
+	};
+
+	Index source;	//numeracja wewnetrzna
+	std::vector<Distance> distance;
+	std::vector<Index> previous;
+	std::vector<PendingArc> pending;
+	bool needs_full;	//od ostatniego update() ktoras waga wzrosla
+	IndexedHeap heap;
+
+	void relax(Index u, Index v, Weight weight);
+	Index dijkstra(const Graph& graph);
+	void addPending(const Graph& graph, Index v1, Index v2, Weight weight);
+};
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "GraphTypes.h"
+
 struct Edge {
-	int v1, v2, weight;
+	Index v1, v2;
+	Weight weight;
 	Edge() {};
-	Edge(int v1, int v2, int weight) : v1(v1), v2(v2), weight(weight) {};
+	Edge(Index v1, Index v2, Weight weight) : v1(v1), v2(v2), weight(weight) {};
 };
\ No newline at end of file
@@ -1,27 +1,42 @@
 #include "EdgeHeap.h"
+#include <cmath>
 
 //dodawanie nowej krawdzi do kopca
-void EdgeHeap::push(Edge* e) {
+void EdgeHeap::push(const Edge& e) {
 
-    Edge** newPointer = new Edge*[heap_length + 1];
-
-    for (int i = 0; i < heap_length; i++) {
-        newPointer[i] = rootPointer[i];
+    //tablica powiekszana jest dwukrotnie dopiero po zapelnieniu, wiec przy
+    //ponownym uzyciu kopca (clear) nie ma juz zadnych alokacji
+    if (heap_length == capacity) {
+        reserve(capacity > 0 ? 2 * capacity : 16);
     }
 
-    newPointer[heap_length] = e;
+    rootPointer[heap_length] = e;
     heap_length++;
 
+    heapifyUp(heap_length >= 2 ? (heap_length - 2) / 2 : 0);
+}
+
+void EdgeHeap::reserve(Index n) {
+
+    if (n <= capacity) {
+        return;
+    }
+
+    Edge* newPointer = new Edge[n];
+
+    for (Index i = 0; i < heap_length; i++) {
+        newPointer[i] = rootPointer[i];
+    }
+
     delete[] rootPointer;
     rootPointer = newPointer;
-
-    heapifyUp(floor((heap_length - 2) / 2));
+    capacity = n;
 }
 
 //usuwanie korzenia kopca
-Edge* EdgeHeap::pop() {
+Edge EdgeHeap::pop() {
 
-    Edge* holder = rootPointer[0];
+    Edge holder = rootPointer[0];
 
     rootPointer[0] = rootPointer[heap_length - 1];
     heap_length--;
@@ -31,15 +46,15 @@ Edge* EdgeHeap::pop() {
     return holder;
 }
 
-void EdgeHeap::heapifyUp(int i) {
-    int l = 2 * i + 1;
-    int r = 2 * i + 2;
-    int smallest;
+void EdgeHeap::heapifyUp(Index i) {
+    Index l = 2 * i + 1;
+    Index r = 2 * i + 2;
+    Index smallest;
 
     if (l < heap_length) {
 
         //sprawdzenie czy lewy potomek jest mniejszy od swojego ojca
-        if (rootPointer[l]->weight < rootPointer[i]->weight) {
+        if (rootPointer[l].weight < rootPointer[i].weight) {
             smallest = l;
         }
         else {
@@ -47,13 +62,13 @@ void EdgeHeap::heapifyUp(int i) {
         }
 
         //sprawdzenie czy prawy potomek jest mniejszy od ojca lub lewego potomka
-        if (r < heap_length && rootPointer[r]->weight < rootPointer[smallest]->weight) {
+        if (r < heap_length && rootPointer[r].weight < rootPointer[smallest].weight) {
             smallest = r;
         }
 
         //zamiana wartoci miejscami
         if (smallest != i) {
-            Edge* holder;
+            Edge holder;
 
             holder = rootPointer[i];
             rootPointer[i] = rootPointer[smallest];
@@ -65,15 +80,15 @@ void EdgeHeap::heapifyUp(int i) {
     if (i > 0) { heapifyUp((i - 1) >> 1); }
 }
 
-void EdgeHeap::heapifyDown(int i) {
-    int l = 2 * i + 1;
-    int r = 2 * i + 2;
-    int smallest;
+void EdgeHeap::heapifyDown(Index i) {
+    Index l = 2 * i + 1;
+    Index r = 2 * i + 2;
+    Index smallest;
 
     if (l > 0 && l < heap_length) {
 
         //sprawdzenie czy lewy potomek jest mniejszy od swojego ojca
-        if (rootPointer[l]->weight < rootPointer[i]->weight) {
+        if (rootPointer[l].weight < rootPointer[i].weight) {
             smallest = l;
         }
         else {
@@ -82,14 +97,14 @@ void EdgeHeap::heapifyDown(int i) {
 
         if (heap_length > 2) {
             //sprawdzenie czy prawy potomek jest wikszy od swojego ojca
-            if (r < heap_length && rootPointer[r]->weight < rootPointer[smallest]->weight) {
+            if (r < heap_length && rootPointer[r].weight < rootPointer[smallest].weight) {
                 smallest = r;
             }
         }
 
         //zamiana wartoci miejscami
         if (smallest != i) {
-            Edge* holder;
+            Edge holder;
 
             holder = rootPointer[i];
             rootPointer[i] = rootPointer[smallest];
@@ -104,13 +119,13 @@ void EdgeHeap::heapifyDown(int i) {
 
 void EdgeHeap::display()
 {
-    if (rootPointer != nullptr) {
+    if (heap_length > 0) {
         display("", "", 0);     //metoda rysujca kopiec
 
         std::cout << std::endl;
 
         //for (int i = 0; i < heap_length; i++) {     //wypisanie tablicowe kopca
-        //    std::cout << rootPointer[i]->weight << ", ";
+        //    std::cout << rootPointer[i].weight << ", ";
         //}
     }
     else {
@@ -118,7 +133,7 @@ void EdgeHeap::display()
     }
 }
 
-void EdgeHeap::display(std::string sp, std::string sn, int from)
+void EdgeHeap::display(std::string sp, std::string sn, Index from)
 {
     std::string cr, cl, cp;
     cr = cl = cp = "  ";
@@ -135,7 +150,7 @@ void EdgeHeap::display(std::string sp, std::string sn, int from)
 
         s = s.substr(0, sp.length() - 2);
 
-        std::cout << s << sn << rootPointer[from]->weight << "\n";
+        std::cout << s << sn << +rootPointer[from].weight << "\n";
 
         s = sp;
         if (sn == cl) s[s.length() - 2] = ' ';
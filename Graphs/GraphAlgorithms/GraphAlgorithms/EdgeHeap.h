@@ -8,6 +8,7 @@ public:
 
 	EdgeHeap() {
 		heap_length = 0;
+		capacity = 0;
 		rootPointer = nullptr;
 	};
 	~EdgeHeap() {
@@ -15,15 +16,19 @@ public:
 	};
 
 	void display();
-	void push(Edge* e);
-	Edge* pop();
+	void push(const Edge& e);
+	Edge pop();
 
-	int heap_length;
+	void reserve(Index n);
+	void clear() { heap_length = 0; }	//pamiec zostaje do ponownego uzycia
+
+	Index heap_length;
 
 private:
-	Edge** rootPointer;
+	Edge* rootPointer;
+	Index capacity;
 
-	void heapifyUp(int i);
-	void heapifyDown(int i);
-	void display(std::string sp, std::string sn, int from);
-};
\ No newline at end of file
+	void heapifyUp(Index i);
+	void heapifyDown(Index i);
+	void display(std::string sp, std::string sn, Index from);
+};
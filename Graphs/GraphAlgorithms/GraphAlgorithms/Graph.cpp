@@ -1,9 +1,11 @@
 #include "Graph.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 
 #include "List.h"
 
-void Graph::add_edge(int pos, int v1, int v2, int weight)
+void Graph::add_edge(Index pos, Index v1, Index v2, Weight weight)
 {
 	graph[pos]->v1 = v1;
 	graph[pos]->v2 = v2;;
@@ -16,41 +18,48 @@ void Graph::display()
 	matrix_rep->display();
 }
 
-void Graph::generateRandomGraph(int graph_order, int graph_density, bool directed)
+void Graph::generateRandomGraph(Index graph_order, int graph_density, bool directed, unsigned seed)
 {
-	for (int i = 0; i < size; i++) {
+	for (Index i = 0; i < size; i++) {
 		delete graph[i];
 	}
 	delete[] graph;
+	ordering.reset();
+	lookup_valid = false;
 
 	order = graph_order;
 
-	int minEdges = order - 1;	//min l. kraw�dzi dla grafu sp�jnego
+	Index minEdges = order - 1;	//min l. kraw�dzi dla grafu sp�jnego
 
-	size = ceil((float)graph_density * order * minEdges / 100);
+	size = (Index)ceil((double)graph_density * order * minEdges / 100);
 	if (!directed) {
 		size /= 2;
 	}
+	if (size < minEdges) {	//przy malej gestosci sama sciezka nie zmiescilaby sie w tablicy
+		size = minEdges;
+	}
 	
+	capacity = size;
 	graph = new Edge* [size];	//alokacja
-	for (int i = 0; i < size; i++) {
+	for (Index i = 0; i < size; i++) {
 		graph[i] = new Edge;
 	}
 
 	//przygotowanie tablicy odwiedzonych wierzcho�k�w
 	int* visited = new int [order];
-	for (int i = 0; i < order; i++) {
+	for (Index i = 0; i < order; i++) {
 		visited[i] = 0;
 	}
 
 	//tworzenie losowej listy kraw�dzi na wz�r pliku
-	srand(time(NULL));
-	int next, previous, weight;
+	srand(seed != 0 ? seed : (unsigned)time(NULL));
+	Index next, previous;
+	Weight weight;
 
 	//utworzenie MST
 	previous = rand() % order;
 	visited[previous] = 1;
-	for (int i = 1; i < minEdges + 1; i++) {
+	for (Index i = 1; i < minEdges + 1; i++) {
 		do {
 			next = rand() % order;
 		} while (visited[next] == 1);
@@ -63,7 +72,7 @@ void Graph::generateRandomGraph(int graph_order, int graph_density, bool directe
 
 	//dope�nienie grafu do zadanej g�sto�ci
 	bool already_connected;
-	for (int i = minEdges; i < size; i++) {
+	for (Index i = minEdges; i < size; i++) {
 		already_connected = true;
 		while (already_connected) {
 			already_connected = false;
@@ -76,7 +85,7 @@ void Graph::generateRandomGraph(int graph_order, int graph_density, bool directe
 				continue;
 			}
 
-			for (int j = 0; j < i; j++) {
+			for (Index j = 0; j < i; j++) {
 				if (graph[j]->v1 == previous && graph[j]->v2 == next) {
 					already_connected = true;
 					break;
@@ -93,55 +102,224 @@ void Graph::generateRandomGraph(int graph_order, int graph_density, bool directe
 	init(directed);
 }
 
+void Graph::generate(const GraphGenerator& generator)
+{
+	for (Index i = 0; i < size; i++) {
+		delete graph[i];
+	}
+	delete[] graph;
+	ordering.reset();
+	lookup_valid = false;
+
+	order = generator.getOrder();
+	size = generator.countEdges();
+	capacity = size;
+	graph = new Edge* [size];
+
+	Index pos = 0;
+	generator.generate([&](Index v1, Index v2, Weight weight) {
+		graph[pos++] = new Edge(v1, v2, weight);
+	});
+	init(generator.isDirected());
+}
+
+namespace
+{
+	std::atomic<unsigned long long> next_version(1);
+}
+
+void Graph::touch()
+{
+	version = next_version++;
+}
+
 void Graph::init(bool directed)
 {
+	this->directed = directed;
+	lookup_valid = false;
+	touch();
 	list_rep->allocate(order);
 	matrix_rep->allocate(size, order);
-	for (int i = 0; i < size; i++) {
+	for (Index i = 0; i < size; i++) {
 		list_rep->addEdge(graph[i]->v1, graph[i]->v2, graph[i]->weight, directed);
 		matrix_rep->addEdge(graph[i]->v1, graph[i]->v2, graph[i]->weight, directed);
 	}
 }
 
-void Graph::loadFromFile(std::string filename) {
+bool Graph::loadFromFile(std::string filename) {
 	std::ifstream myFile;
-	int v1, v2, weight;
+	Index v1 = 0, v2 = 0;
+	Weight weight = 0;
 
 	myFile.open(filename);
 
 	if (!myFile.is_open())
 	{
 		std::cerr << "Error: Failed to open file: " << filename << std::endl;
-		return;
+		return false;
 	}
 
 	{
 		//usuni�cie poprzedniego grafu
-		for (int i = 0; i < size; i++) {
+		for (Index i = 0; i < size; i++) {
 			delete graph[i];
 		}
 		delete[] graph;
+		graph = nullptr;
+		size = 0;
+		capacity = 0;
+		order = 0;
+		ordering.reset();
+		lookup_valid = false;
 
 		//pobranie ilo�ci warto�ci do odczytania z pierwszej linijki pliku
-		myFile >> size >> order;	//size - kraw�dzie, order - wierzcho�ki
+		if (!(myFile >> size >> order)) {	//size - kraw�dzie, order - wierzcho�ki
+			std::cerr << "Error: Invalid header in file: " << filename << std::endl;
+			size = 0;
+			order = 0;
+			return false;
+		}
 
 		//alokacja 
+		capacity = size;
 		graph = new Edge * [size];
-		for (int i = 0; i < size; i++) {
+		for (Index i = 0; i < size; i++) {
 			graph[i] = new Edge;
 		}
 
 		//wczytywanie kraw�dzi
-		for (int i = 0; i < size; i++) {
-			myFile >> v1 >> v2 >> weight;
+		for (Index i = 0; i < size; i++) {
+			if (!(myFile >> v1 >> v2) || !readWeight(myFile, weight) || v1 >= order || v2 >= order) {
+				std::cerr << "Error: Malformed edge " << i + 1 << " in file: " << filename << std::endl;
+				//graf czesciowy nie jest zgodny z plikiem - zostaje pusty
+				for (Index j = 0; j < size; j++) {
+					delete graph[j];
+				}
+				delete[] graph;
+				graph = nullptr;
+				size = 0;
+				capacity = 0;
+				order = 0;
+				return false;
+			}
 			add_edge(i, v1, v2, weight);
 		}
 
 		myFile.close();
 	}
+	return true;
+}
+
+void Graph::reorder(VertexOrdering::Kind kind)
+{
+	VertexOrdering step;
+	step.compute(graph, size, order, kind);
+	if (step.isIdentity()) {
+		return;
+	}
+	ordering.append(step);
+
+	for (Index i = 0; i < size; i++) {
+		graph[i]->v1 = step.new_id[graph[i]->v1];
+		graph[i]->v2 = step.new_id[graph[i]->v2];
+	}
+	//krawedzie w kolejnosci wierzcholkow - wezly list sasiedztwa alokowane sa wtedy
+	//mniej wiecej w kolejnosci, w jakiej beda przegladane
+	std::sort(graph, graph + size, [](const Edge* a, const Edge* b) {
+		return a->v1 < b->v1 || (a->v1 == b->v1 && a->v2 < b->v2);
+	});
+	init(directed);
+}
+
+Graph::EdgeKey Graph::edgeKey(Index v1, Index v2) const
+{
+	if (!directed && v2 < v1) {
+		return { v2, v1 };
+	}
+	return { v1, v2 };
+}
+
+Index Graph::findEdge(Index v1, Index v2)
+{
+	if (!lookup_valid) {
+		edge_lookup.clear();
+		edge_lookup.reserve(size);
+		for (Index i = 0; i < size; i++) {
+			edge_lookup.emplace(edgeKey(graph[i]->v1, graph[i]->v2), i);	//przy krawedziach wielokrotnych pierwsza
+		}
+		lookup_valid = true;
+	}
+	auto found = edge_lookup.find(edgeKey(v1, v2));
+	return found == edge_lookup.end() ? NO_INDEX : found->second;
+}
+
+void Graph::insertEdge(Index v1, Index v2, Weight weight)
+{
+	v1 = toInternal(v1);
+	v2 = toInternal(v2);
+	if (size == capacity) {
+		capacity = capacity < 4 ? 8 : capacity * 2;
+		Edge** edges = new Edge*[capacity];
+		for (Index i = 0; i < size; i++) {
+			edges[i] = graph[i];
+		}
+		delete[] graph;
+		graph = edges;
+	}
+	graph[size] = new Edge(v1, v2, weight);
+	if (lookup_valid) {
+		edge_lookup.emplace(edgeKey(v1, v2), size);
+	}
+	size++;
+
+	list_rep->addEdge(v1, v2, weight, directed);
+	matrix_rep->appendEdge(v1, v2, weight, directed);
+	touch();
+}
+
+bool Graph::getEdgeWeight(Index v1, Index v2, Weight& weight)
+{
+	Index i = findEdge(toInternal(v1), toInternal(v2));
+	if (i == NO_INDEX) {
+		return false;
+	}
+	weight = graph[i]->weight;
+	return true;
+}
+
+bool Graph::setEdgeWeight(Index v1, Index v2, Weight weight)
+{
+	v1 = toInternal(v1);
+	v2 = toInternal(v2);
+	Index i = findEdge(v1, v2);
+	if (i == NO_INDEX) {
+		return false;
+	}
+	graph[i]->weight = weight;
+	//v1, v2 w kolejnosci zapisanej - w grafie nieskierowanym mogly byc podane odwrotnie
+	list_rep->setWeight(graph[i]->v1, graph[i]->v2, weight, directed);
+	matrix_rep->setWeight(i, weight);	//kolumny macierzy odpowiadaja kolejnosci krawedzi
+	touch();
+	return true;
 }
 
-int Graph::minDensity(int graph_order, bool directed)
+//przepisuje wynik z numeracji wewnetrznej na oryginalna (zwalnia przekazany wynik)
+PathResult* Graph::toOriginalIds(PathResult* result) const
+{
+	if (ordering.isIdentity()) {
+		return result;
+	}
+	PathResult* mapped = new PathResult(order, toOriginal(result->getSource()));
+	for (Index v = 0; v < order; v++) {
+		Index u = toOriginal(v);
+		mapped->distance[u] = result->distance[v];
+		mapped->previous[u] = result->previous[v] == NO_INDEX ? NO_INDEX : toOriginal(result->previous[v]);
+	}
+	delete result;
+	return mapped;
+}
+
+int Graph::minDensity(Index graph_order, bool directed)
 {	
 	if (directed) {
 		return ceil((float)1 / graph_order * 100);
@@ -157,10 +335,12 @@ void Graph::mst_kruskal()	//wynikiem algorytmu jest lista kraw�dzi
 	std::cout << "Minimalne drzewo rozpinajace bedace wynikiem algorytmu Kruskala \n";
 	std::cout << "\nZ reprezentacji macierzowej: \n";
 	mst = matrix_rep->mst_kruskal();
+	mst->relabel(ordering.original_id);
 	std::cout << mst->toString() << std::endl;
 	std::cout << "Calkowita waga MST: " << mst->sumWeight() << std::endl;
 	std::cout << "\nZ reprezentacji listowej: \n";
 	mst = list_rep->mst_kruskal();
+	mst->relabel(ordering.original_id);
 	std::cout << mst->toString() << std::endl;
 	std::cout << "Calkowita waga MST: " << mst->sumWeight() << std::endl;
 }
@@ -171,53 +351,53 @@ void Graph::mst_prim()	//wynikiem algorytmu jest lista kraw�dzi
 	std::cout << "Minimalne drzewo rozpinajace bedace wynikiem algorytmu Prima \n";
 	std::cout << "\nZ reprezentacji macierzowej: \n";
 	mst = matrix_rep->mst_prim();
+	mst->relabel(ordering.original_id);
 	std::cout << mst->toString() << std::endl;
 	std::cout << "Calkowita waga MST: " << mst->sumWeight() << std::endl;
 	std::cout << "\nZ reprezentacji listowej: \n";
 	mst = list_rep->mst_prim();
+	mst->relabel(ordering.original_id);
 	std::cout << mst->toString() << std::endl;
 	std::cout << "Calkowita waga MST: " << mst->sumWeight() << std::endl;
 }
 
-void Graph::spp_dijkstra(int vp, int vk)	//wynikiem algorytmu jest �cie�ka i koszt
+PathResult* Graph::spp_dijkstra_matrix(Index vp)
 {
-	std::string spp;
-	std::cout << "Najkrotsza sciezka z \n" << vp << " do " << vk << "\n";
-	std::cout << "\nZ reprezentacji macierzowej: \n";
-	spp = matrix_rep->spp_dijkstra(vp, vk);
-	std::cout << spp;
-	std::cout << "\nZ reprezentacji listowej: \n";
-	spp = list_rep->spp_dijkstra(vp, vk);
-	std::cout << spp;
+	return toOriginalIds(matrix_rep->spp_dijkstra(toInternal(vp)));
+}
+
+PathResult* Graph::spp_dijkstra_list(Index vp)
+{
+	return toOriginalIds(list_rep->spp_dijkstra(toInternal(vp)));
 }
 
 // Benchmarking methods - run algorithms on specific representation only (no output)
-void Graph::mst_prim_matrix()
+void Graph::mst_prim_matrix(Workspace& ws)
 {
-	matrix_rep->mst_prim();
+	matrix_rep->mst_prim(ws);
 }
 
-void Graph::mst_prim_list()
+void Graph::mst_prim_list(Workspace& ws)
 {
-	list_rep->mst_prim();
+	list_rep->mst_prim(ws);
 }
 
-void Graph::mst_kruskal_matrix()
+void Graph::mst_kruskal_matrix(Workspace& ws)
 {
-	matrix_rep->mst_kruskal();
+	matrix_rep->mst_kruskal(ws);
 }
 
-void Graph::mst_kruskal_list()
+void Graph::mst_kruskal_list(Workspace& ws)
 {
-	list_rep->mst_kruskal();
+	list_rep->mst_kruskal(ws);
 }
 
-void Graph::spp_dijkstra_matrix(int vp, int vk)
+void Graph::spp_dijkstra_matrix(Index vp, Workspace& ws)
 {
-	matrix_rep->spp_dijkstra(vp, vk);
+	matrix_rep->spp_dijkstra(toInternal(vp), ws);
 }
 
-void Graph::spp_dijkstra_list(int vp, int vk)
+void Graph::spp_dijkstra_list(Index vp, Workspace& ws)
 {
-	list_rep->spp_dijkstra(vp, vk);
+	list_rep->spp_dijkstra(toInternal(vp), ws);
 }
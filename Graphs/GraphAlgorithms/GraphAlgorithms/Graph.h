@@ -5,7 +5,10 @@
 #include "List.h"
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
 #include "Edge.h"
+#include "VertexOrdering.h"
+#include "GraphGenerator.h"
 
 class Graph
 {
@@ -15,52 +18,102 @@ public:
 		list_rep = new AdjacencyList();
 		graph = nullptr;
 		size = 0;
+		capacity = 0;
 		order = 0;
+		directed = false;
+		version = 0;
+		lookup_valid = false;
 	};
 	~Graph() {
 		delete matrix_rep;
 		delete list_rep;
 
-		for (int i = 0; i < order; i++) {
+		for (Index i = 0; i < size; i++) {
 			delete graph[i];
 		}
-		delete graph;
+		delete[] graph;
 	};
 
 	const int MAX_WEIGHT = 97;
 
 	void display();
 	
-	void generateRandomGraph(int graph_order, int graph_density, bool directed);
-	void loadFromFile(std::string filename);
+	//seed = 0 - ziarno z zegara
+	void generateRandomGraph(Index graph_order, int graph_density, bool directed, unsigned seed = 0);
+	//tablica krawedzi wypelniana wprost z generatora (rozmiar znany przed generowaniem)
+	void generate(const GraphGenerator& generator);
+	bool loadFromFile(std::string filename);	//false przy bledzie; po blednym pliku graf jest pusty
 	void init(bool directed);
-	int minDensity(int graph_order, bool directed);
+	int minDensity(Index graph_order, bool directed);
+
+	//przenumerowanie wierzcholkow i odbudowa reprezentacji; metody Graph przyjmuja i zwracaja
+	//dalej numery oryginalne, reprezentacje (matrix_rep, list_rep) pracuja na nowych
+	void reorder(VertexOrdering::Kind kind);
+	Index toInternal(Index v) const { return ordering.toNew(v); }
+	Index toOriginal(Index v) const { return ordering.toOriginal(v); }
+	//zmiany grafu w miejscu, bez przebudowy reprezentacji (numery oryginalne);
+	//kazda zmiana nadaje grafowi nowa wersje
+	void insertEdge(Index v1, Index v2, Weight weight);
+	bool setEdgeWeight(Index v1, Index v2, Weight weight);	//false - brak krawedzi
+	bool hasEdge(Index v1, Index v2) { return findEdge(toInternal(v1), toInternal(v2)) != NO_INDEX; }
+	bool getEdgeWeight(Index v1, Index v2, Weight& weight);	//false - brak krawedzi
+	Edge edgeAt(Index i) const { return Edge(toOriginal(graph[i]->v1), toOriginal(graph[i]->v2), graph[i]->weight); }
+	bool isDirected() const { return directed; }
+
+	Index bandwidth() const { return VertexOrdering::bandwidth(graph, size); }
+	double averageSpan() const { return VertexOrdering::averageSpan(graph, size); }
 
 	void mst_kruskal();
 	void mst_prim();
-	void spp_dijkstra(int vp, int vk);
 
-	void mst_prim_matrix();
-	void mst_prim_list();
-	void mst_kruskal_matrix();
-	void mst_kruskal_list();
-	void spp_dijkstra_matrix(int vp, int vk);
-	void spp_dijkstra_list(int vp, int vk);
+	PathResult* spp_dijkstra_matrix(Index vp);
+	PathResult* spp_dijkstra_list(Index vp);
 
-	int getSize() const { return size; }
-	int getOrder() const { return order; }
+	//wersje do pomiarow - wynik zostaje w pamieci roboczej ws (w numeracji wewnetrznej)
+	void mst_prim_matrix(Workspace& ws);
+	void mst_prim_list(Workspace& ws);
+	void mst_kruskal_matrix(Workspace& ws);
+	void mst_kruskal_list(Workspace& ws);
+	void spp_dijkstra_matrix(Index vp, Workspace& ws);
+	void spp_dijkstra_list(Index vp, Workspace& ws);
+
+	Index getSize() const { return size; }
+	//zmienia sie przy kazdej przebudowie reprezentacji, unikalna pomiedzy obiektami Graph
+	unsigned long long getVersion() const { return version; }
+	Index getOrder() const { return order; }
 
 	IncidencyMatrix* matrix_rep;
 	AdjacencyList* list_rep;
 
 private:
 
-	int size;
-	int order;
+	Index size;
+	Index capacity;	//zaalokowane miejsca w tablicy graph
+	Index order;
+	bool directed;
+	unsigned long long version;
 
 	Edge** graph;
+	VertexOrdering ordering;	//numeracja wewnetrzna wzgledem oryginalnej
+
+	//polozenie krawedzi w tablicy graph wedlug koncow (numeracja wewnetrzna, w grafie
+	//nieskierowanym mniejszy numer pierwszy); budowane przy pierwszej zmianie grafu
+	struct EdgeKey {
+		Index v1, v2;
+		bool operator==(const EdgeKey& other) const { return v1 == other.v1 && v2 == other.v2; }
+	};
+	struct EdgeKeyHash {
+		size_t operator()(const EdgeKey& key) const { return std::hash<Index>()(key.v1) * 31 + std::hash<Index>()(key.v2); }
+	};
+	std::unordered_map<EdgeKey, Index, EdgeKeyHash> edge_lookup;
+	bool lookup_valid;
+
+	EdgeKey edgeKey(Index v1, Index v2) const;
+	Index findEdge(Index v1, Index v2);
+	void touch();
 
-	void add_edge(int pos, int v1, int v2, int weight);
+	void add_edge(Index pos, Index v1, Index v2, Weight weight);
+	PathResult* toOriginalIds(PathResult* result) const;
 
 };
 
@@ -1,12 +1,114 @@
 ﻿
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <fstream>
 #include <vector>
 #include <cmath>
 #include <iomanip>
+#include <limits>
+#include <mutex>
+#include <random>
 #include "Timer.h"
 #include "Graph.h"
+#include "AltShortestPaths.h"
+#include "BatchShortestPaths.h"
+#include "ContractionHierarchy.h"
+#include "GraphGenerator.h"
+#include "QueryServer.h"
+#include "ShortestPathCache.h"
+#include "DynamicMST.h"
+#include "DynamicShortestPaths.h"
+
+// Returns the value following "name" among the optional trailing arguments
+int intOption(int argc, char* argv[], int first, const std::string& name, int fallback) {
+    for (int i = first; i + 1 < argc; i++) {
+        if (name == argv[i]) {
+            return std::stoi(argv[i + 1]);
+        }
+    }
+    return fallback;
+}
+
+// Same as intOption, for text values
+std::string stringOption(int argc, char* argv[], int first, const std::string& name, const std::string& fallback) {
+    for (int i = first; i + 1 < argc; i++) {
+        if (name == argv[i]) {
+            return argv[i + 1];
+        }
+    }
+    return fallback;
+}
+
+double calculateAverage(const std::vector<double>& times) {
+    if (times.empty()) return 0.0;
+    double sum = 0.0;
+    for (double t : times) {
+        sum += t;
+    }
+    return sum / times.size();
+}
+
+double calculateStdDev(const std::vector<double>& times, double avg) {
+    if (times.empty() || times.size() == 1) return 0.0;
+    double sumSquaredDiff = 0.0;
+    for (double t : times) {
+        double diff = t - avg;
+        sumSquaredDiff += diff * diff;
+    }
+    return std::sqrt(sumSquaredDiff / times.size());
+}
+
+// Prints average and standard deviation of one measured series to both streams
+void printSeries(std::ostream& outFile, const std::string& label, const std::vector<double>& times) {
+    if (times.empty()) return;
+    double avg = calculateAverage(times);
+    double stdDev = calculateStdDev(times, avg);
+    for (std::ostream* out : { &outFile, &std::cout }) {
+        *out << "  " << label << ":\n";
+        *out << "    Average: " << std::fixed << std::setprecision(4) << avg << " ms\n";
+        *out << "    Std Dev: " << std::fixed << std::setprecision(4) << stdDev << " ms\n";
+    }
+}
+
+// Formats the path from the result's source to vk: "[vp] ... [vk]" followed by its cost
+std::string formatPath(const PathResult& result, Index vk) {
+    if (!result.reachable(vk)) {
+        return "Brak sciezki do wierzcholka " + std::to_string(vk) + "\n";
+    }
+    std::vector<Index> path(result.pathLength(vk));
+    result.extractPath(vk, path.data());
+
+    std::string text;
+    for (Index v : path) {
+        text += "[" + std::to_string(v) + "] ";
+    }
+    text += "\n Calkowity koszt sciezki: " + formatNumber(result.distance[vk]) + "\n";
+    return text;
+}
+
+// Draws a vertex pair with no edge between them for the update benchmarks; false when
+// the graph is complete or no free pair turned up within a bounded number of attempts
+bool pickFreePair(Graph& graph, std::mt19937& random, Index& v1, Index& v2) {
+    const int maxAttempts = 1000;
+    Index order = graph.getOrder();
+    unsigned long long maxEdges = (unsigned long long)order * (order - 1);
+    if (!graph.isDirected()) {
+        maxEdges /= 2;
+    }
+    if (order < 2 || graph.getSize() >= maxEdges) {
+        return false;
+    }
+    std::uniform_int_distribution<Index> vertex(0, order - 1);
+    for (int attempt = 0; attempt < maxAttempts; attempt++) {
+        v1 = vertex(random);
+        v2 = vertex(random);
+        if (v1 != v2 && !graph.hasEdge(v1, v2)) {
+            return true;
+        }
+    }
+    return false;
+}
 
 void showHelp() {
     std::cout << "FILE TEST MODE:\n"
@@ -17,27 +119,99 @@ void showHelp() {
         << "        For MST (e.g. 0 - all, 1 - Prim's, 2 - Kruskal's)\n"
         << "        For shortest (1 - Dijkstra)\n"
         << "    <inputFile> Input file containing the graf.\n"
-        << "    [outputFile] If provided, solved problem will be stored there.\n\n"
+        << "    [outputFile] If provided, solved problem will be stored there.\n"
+        << "    Options:\n"
+        << "    --reorder <order> Relabel vertices before solving (0 - none, 1 - BFS,\n"
+        << "        2 - Reverse Cuthill-McKee, 3 - by degree); results keep original ids.\n\n"
         << "BENCHMARK MODE:\n"
         << "    Usage:\n"
         << "        ./GraphAlgorithms --test <problem> <algorithm> <size> <density> <count>\n"
         << "                <outputFile>\n"
         << "    <problem> Problem to solve (e.g. 0 - MST, 1 - shortest path)\n"
         << "    <algorithm> Algorithm for the problem\n"
-        << "        For MST (e.g. 0 - all, 1 - Prim's, 2 - Kruskal's)\n"
-        << "        For shortest (1 - Dijkstra)\n"
+        << "        For MST (e.g. 0 - all, 1 - Prim's, 2 - Kruskal's,\n"
+        << "            3 - Prim's over binary/4-ary/8-ary/pairing heaps,\n"
+        << "            4 - incremental MST under edge updates vs full rerun)\n"
+        << "        For shortest (1 - Dijkstra, 2 - all-pairs: batched Dijkstra\n"
+        << "            vs blocked Floyd-Warshall,\n"
+        << "            3 - Dijkstra over binary/4-ary/8-ary/pairing heaps,\n"
+        << "            4 - point-to-point queries with and without the path tree cache,\n"
+        << "            5 - incremental shortest paths under edge updates vs full rerun,\n"
+        << "            6 - point-to-point queries: ALT (A* with landmarks) vs spp_dijkstra,\n"
+        << "            7 - point-to-point queries: contraction hierarchies vs spp_dijkstra)\n"
         << "    <size> Number of nodes.\n"
         << "    <density> Density of edges.\n"
         << "    <count> How many times test should be repeated (with graph regen).\n"
         << "    <outputFile> File where the benchmark results should be saved\n"
-        << "        (every measured time is stored in seperate line).\n\n"
+        << "        (every measured time is stored in seperate line).\n"
+        << "    Weight and vertex index types are chosen at build time (CMake options\n"
+        << "        GRAPH_WEIGHT_TYPE: uint8, uint16, int32, int64, float and\n"
+        << "        GRAPH_INDEX_TYPE: uint32, uint64); this build: " GRAPH_WEIGHT_NAME " weights,\n"
+        << "        " GRAPH_INDEX_NAME " indices.\n"
+        << "    Options:\n"
+        << "    --threads <n> Worker threads for batched algorithms\n"
+        << "        (default: all hardware threads).\n"
+        << "    --reorder <order> Also time Prim's/Dijkstra's (List) after relabeling\n"
+        << "        vertices (1 - BFS, 2 - Reverse Cuthill-McKee, 3 - by degree)\n"
+        << "        and report the reorder cost separately.\n"
+        << "    --queries <n> Point-to-point queries per graph (default: 1000).\n"
+        << "    --sources <n> Distinct sources those queries are drawn from (default: 16).\n"
+        << "    --cache <MB> Path tree cache budget (default: 64).\n"
+        << "    --updates <n> Edge updates per graph for the dynamic benchmarks (default: 100).\n"
+        << "    --update-batch <n> Updates applied between shortest path refreshes (default: 5).\n"
+        << "    --landmarks <k> Landmarks for the ALT benchmark (default: 8).\n"
+        << "    --landmark-select <0|1> Landmark selection: 0 - farthest, 1 - avoid (default: 1).\n"
+        << "    --generator <kind> Graph generator: 0 - uniform random on a Hamiltonian path\n"
+        << "        (default), 1 - R-MAT power-law, 2 - perturbed 2D grid (road-like, about two\n"
+        << "        edges per vertex, ignores density), 3 - random geometric.\n"
+        << "    --seed <n> Seed of the first graph, the next ones use n + 1, n + 2, ...\n"
+        << "        (default: 0 - a different graph every run).\n"
+        << "    --degree <d> Average out-degree for generators 1 and 3 instead of <density>,\n"
+        << "        for sparse graphs too large to express in percent.\n\n"
+        << "BATCH QUERY MODE:\n"
+        << "    Usage:\n"
+        << "        ./GraphAlgorithms --batch <inputFile> <queryFile> <outputFile> [options]\n"
+        << "    <queryFile> First line: number of queries, then one \"vp vk\" pair per line.\n"
+        << "    <outputFile> One line per query, written as soon as its source is done:\n"
+        << "        \"<query#> <vp> <vk> <cost> <path...>\" or \"<query#> <vp> <vk> unreachable\".\n"
+        << "    Queries are grouped by source (one Dijkstra per distinct source) and the\n"
+        << "        groups run in parallel; the report leads with queries per second.\n"
+        << "    Options:\n"
+        << "    --threads <n> Worker threads (default: all hardware threads).\n"
+        << "    --directed <0|1> Directed graph (default: 1).\n"
+        << "    --reorder <order> Relabel vertices before answering (see FILE TEST MODE).\n\n"
+        << "SERVER MODE:\n"
+        << "    Usage:\n"
+        << "        ./GraphAlgorithms --server <inputFile> [options]\n"
+        << "        ./GraphAlgorithms --server --random <size> <density> [options]\n"
+        << "    Loads (or generates) the graph once and answers queries, one per line:\n"
+        << "        dijkstra <vp> <vk>, mst prim, mst kruskal, info, stats,\n"
+        << "        quit (ends the session), shutdown (stops a socket server).\n"
+        << "    Every answer is one line starting with \"ok\" or \"error\" and ending\n"
+        << "        with the query latency (time_us <microseconds>).\n"
+        << "    Options:\n"
+        << "    --directed <0|1> Directed graph for shortest paths (default: 1);\n"
+        << "        mst queries need an undirected one.\n"
+        << "    --socket <path> Listen on a Unix socket instead of stdin/stdout.\n"
+        << "    --cache <MB> Keep shortest path trees of recent sources (default: 0 - off).\n"
+        << "    --reorder <order> Relabel vertices once at startup (see FILE TEST MODE).\n\n"
+        << "GENERATOR MODE:\n"
+        << "    Usage:\n"
+        << "        ./GraphAlgorithms --generate <kind> <size> <density> <outputFile> [options]\n"
+        << "    <kind> 1 - R-MAT, 2 - perturbed grid, 3 - random geometric (see --generator).\n"
+        << "    Edges are written as they are generated, in the --file input format, so\n"
+        << "        graphs larger than memory allows for the benchmark can be produced.\n"
+        << "    Options:\n"
+        << "    --directed <0|1> Directed graph (default: 1).\n"
+        << "    --seed <n> Generator seed (default: 0 - random).\n"
+        << "    --degree <d> Average out-degree instead of <density>.\n\n"
         << "HELP MODE:\n"
         << "    Usage:\n"
         << "        ./GraphAlgorithms --help\n"
         << "    Displays this help message.\n"
         << "    Notes:\n"
         << "    - The help message will also appear if no arguments are provided.\n"
-        << "    - Ensure that either --file or --test mode is specified;\n"
+        << "    - Ensure that exactly one of --file, --test, --batch, --server or --generate is specified;\n"
         << "        they are mutually exclusive.\n";
 }
 
@@ -60,17 +234,22 @@ int main(int argc, char* argv[]) {
         int problem = std::stoi(argv[2]);
         int algorithm = std::stoi(argv[3]);
         std::string inputFile = argv[4];
-        std::string outputFile = (argc >= 6) ? argv[5] : "";
+        std::string outputFile = (argc >= 6 && argv[5][0] != '-') ? argv[5] : "";
+        int reorderKind = intOption(argc, argv, 5, "--reorder", 0);
 
         // Validate problem type
         if (problem != 0 && problem != 1) {
             std::cerr << "Error: Invalid problem type. Use 0 for MST, 1 for shortest path.\n";
             return 1;
         }
+        if (reorderKind < 0 || reorderKind > 3) {
+            std::cerr << "Error: Invalid vertex order. Use 0 (none), 1 (BFS), 2 (RCM) or 3 (degree).\n";
+            return 1;
+        }
 
         // Read file header to verify format
         std::ifstream verifyFile(inputFile);
-        int declaredEdges, declaredVertices;
+        long long declaredEdges, declaredVertices;
         if (!verifyFile.is_open()) {
             std::cerr << "Error: Could not open input file: " << inputFile << "\n";
             return 1;
@@ -89,11 +268,13 @@ int main(int argc, char* argv[]) {
 
         // Load graph from file
         Graph graph;
-        graph.loadFromFile(inputFile);
+        if (!graph.loadFromFile(inputFile)) {
+            return 1;
+        }
         
         // Verify loaded graph matches declared values
-        int loadedEdges = graph.getSize();
-        int loadedVertices = graph.getOrder();
+        long long loadedEdges = graph.getSize();
+        long long loadedVertices = graph.getOrder();
         
         std::cout << "Loaded from structure: " << loadedEdges << " edges, " << loadedVertices << " vertices\n";
         
@@ -131,6 +312,26 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        // Optional relabeling for locality - everything below still reports original vertex ids
+        if (reorderKind != 0) {
+            VertexOrdering::Kind kind = (VertexOrdering::Kind)reorderKind;
+            Index bandwidthBefore = graph.bandwidth();
+            double spanBefore = graph.averageSpan();
+            timer.reset();
+            timer.start();
+            graph.reorder(kind);
+            timer.stop();
+            double reorderTime = timer.resultNs() / 1e6;
+
+            std::cout << "\n=== Vertex Reordering (" << VertexOrdering::name(kind) << ") ===\n";
+            for (std::ostream* out : { (std::ostream*)&std::cout, (std::ostream*)&outFile }) {
+                if (out == &outFile && !outFile.is_open()) continue;
+                *out << "Bandwidth: " << bandwidthBefore << " -> " << graph.bandwidth()
+                     << ", average edge span: " << spanBefore << " -> " << graph.averageSpan() << "\n";
+                *out << "Reorder time: " << reorderTime << " ms\n";
+            }
+        }
+
         // Execute algorithm based on problem type
         if (problem == 0) { // MST
             std::cout << "\n=== Minimum Spanning Tree (MST) Solution ===\n";
@@ -187,8 +388,8 @@ int main(int argc, char* argv[]) {
             }
         }
         else if (problem == 1) { // Shortest path
-            int startVertex;
-            int endVertex;
+            Index startVertex;
+            Index endVertex;
             std::cout << "Do you want to add start and end vertex? (y/n)";
             char answer;
             std::cin >> answer;
@@ -205,31 +406,36 @@ int main(int argc, char* argv[]) {
             std::cout << "\n=== Shortest Path Solution ===\n";
             std::cout << "Finding path from vertex " << startVertex << " to vertex " << endVertex << "\n";
             
-            if (algorithm == 0) { // All shortest path algorithms
+            if (algorithm == 0 || algorithm == 1) { // Dijkstra's
                 std::cout << "\n--- Dijkstra's Algorithm ---\n";
+
+                // Only the algorithms are timed - the paths are formatted afterwards
                 timer.reset();
                 timer.start();
-                graph.spp_dijkstra(startVertex, endVertex);
+                PathResult* matrixPath = graph.spp_dijkstra_matrix(startVertex);
                 timer.stop();
-                std::cout << "Time elapsed: " << timer.result() << " ms\n";
-                if (outFile.is_open()) {
-                    outFile << "=== Dijkstra's Algorithm ===\n";
-                    outFile << "From vertex " << startVertex << " to vertex " << endVertex << "\n";
-                    outFile << "Time: " << timer.result() << " ms\n";
-                }
-            }
-            else if (algorithm == 1) { // Dijkstra's
-                std::cout << "\n--- Dijkstra's Algorithm ---\n";
+                int matrixTime = timer.result();
+
                 timer.reset();
                 timer.start();
-                graph.spp_dijkstra(startVertex, endVertex);
+                PathResult* listPath = graph.spp_dijkstra_list(startVertex);
                 timer.stop();
-                std::cout << "Time elapsed: " << timer.result() << " ms\n";
+                int listTime = timer.result();
+
+                std::cout << "\nZ reprezentacji macierzowej: \n" << formatPath(*matrixPath, endVertex);
+                std::cout << "\nZ reprezentacji listowej: \n" << formatPath(*listPath, endVertex);
+                std::cout << "\nTime elapsed (matrix): " << matrixTime << " ms\n";
+                std::cout << "Time elapsed (list): " << listTime << " ms\n";
                 if (outFile.is_open()) {
                     outFile << "=== Dijkstra's Algorithm ===\n";
                     outFile << "From vertex " << startVertex << " to vertex " << endVertex << "\n";
-                    outFile << "Time: " << timer.result() << " ms\n";
+                    outFile << formatPath(*listPath, endVertex) << "\n";
+                    outFile << "Time (matrix): " << matrixTime << " ms\n";
+                    outFile << "Time (list): " << listTime << " ms\n";
                 }
+
+                delete matrixPath;
+                delete listPath;
             }
             else {
                 std::cerr << "Error: Invalid algorithm for shortest path. Use 0 (all) or 1 (Dijkstra).\n";
@@ -256,11 +462,35 @@ int main(int argc, char* argv[]) {
         int density = std::stoi(argv[5]);
         int count = std::stoi(argv[6]);
         std::string outputFile = argv[7];
+        int threads = intOption(argc, argv, 8, "--threads", 0);
+        int reorderKind = intOption(argc, argv, 8, "--reorder", 0);
+        int queryCount = intOption(argc, argv, 8, "--queries", 1000);
+        int sourceCount = intOption(argc, argv, 8, "--sources", 16);
+        int cacheMB = intOption(argc, argv, 8, "--cache", 64);
+        int updateCount = intOption(argc, argv, 8, "--updates", 100);
+        int updateBatch = std::max(1, intOption(argc, argv, 8, "--update-batch", 5));
+        int landmarkCount = std::max(0, intOption(argc, argv, 8, "--landmarks", 8));
+        int landmarkSelect = intOption(argc, argv, 8, "--landmark-select", 1);
+        int generatorKind = intOption(argc, argv, 8, "--generator", 0);
+        int seed = intOption(argc, argv, 8, "--seed", 0);
+        int degree = intOption(argc, argv, 8, "--degree", 0);
 
         if (problem != 0 && problem != 1) {
             std::cerr << "Error: Invalid problem type. Use 0 for MST, 1 for shortest path.\n";
             return 1;
         }
+        if (reorderKind < 0 || reorderKind > 3) {
+            std::cerr << "Error: Invalid vertex order. Use 0 (none), 1 (BFS), 2 (RCM) or 3 (degree).\n";
+            return 1;
+        }
+        if (generatorKind < 0 || generatorKind > 3) {
+            std::cerr << "Error: Invalid generator. Use 0 (uniform), 1 (R-MAT), 2 (grid) or 3 (geometric).\n";
+            return 1;
+        }
+        if (landmarkSelect != 0 && landmarkSelect != 1) {
+            std::cerr << "Error: Invalid landmark selection. Use 0 (farthest) or 1 (avoid).\n";
+            return 1;
+        }
 
         std::ofstream outFile(outputFile);
         if (!outFile.is_open()) {
@@ -272,9 +502,12 @@ int main(int argc, char* argv[]) {
                   << ", algorithm=" << algorithm 
                   << ", size=" << size 
                   << ", density=" << density 
-                  << ", count=" << count << "\n";
+                  << ", count=" << count
+                  << ", generator=" << (generatorKind == 0 ? "uniform" : GraphGenerator::name((GraphGenerator::Kind)(generatorKind - 1)))
+                  << ", weights=" GRAPH_WEIGHT_NAME ", indices=" GRAPH_INDEX_NAME "\n";
 
         Timer timer;
+        Workspace workspace; // reused by every run, so steady-state runs do not allocate
         bool directed = (problem == 1); // Shortest path uses directed graphs
 
         // Uzywam tutaj vectorow do przechowywania czasow dla kazdego algorytmu i reprezentacji
@@ -284,16 +517,113 @@ int main(int argc, char* argv[]) {
         std::vector<double> kruskalTimesList;
         std::vector<double> dijkstraTimesMatrix;
         std::vector<double> dijkstraTimesList;
+        std::vector<double> repeatedDijkstraTimes;
+        std::vector<double> batchDijkstraTimes;
+        std::vector<double> floydWarshallTimes;
+
+        // Priority queue comparison (list representation, same workspace)
+        const char* heapNames[] = { "Binary", "4ary", "8ary", "Pairing" };
+        std::vector<double> heapTimes[4];
+        DaryHeap<2> binaryHeap;
+        DaryHeap<4> fourAryHeap;
+        DaryHeap<8> eightAryHeap;
+        PairingHeap pairingHeap;
+
+        // Vertex reordering: the same list algorithm timed before and after relabeling
+        VertexOrdering::Kind reorder = (VertexOrdering::Kind)reorderKind;
+        std::vector<double> reorderTimes;
+        std::vector<double> originalOrderTimes;
+        std::vector<double> reorderedTimes;
+        double bandwidthBefore = 0.0;
+        double bandwidthAfter = 0.0;
+
+        // Point-to-point queries: full search per query vs shortest path tree cache
+        std::vector<double> uncachedQueryTimes;
+        std::vector<double> cachedQueryTimes;
+        long long cacheHits = 0;
+        long long cacheMisses = 0;
+        long long cacheEvictions = 0;
+        long long cacheMismatches = 0;
+        long long cacheUnreachable = 0;
+        std::mt19937 queryRandom(12345);
+
+        // Dynamic graph: per-update latency of the incremental structure vs a full rerun
+        std::vector<double> incrementalUpdateTimes;
+        std::vector<double> rerunUpdateTimes;
+        long long updateMismatches = 0;
+        long long affectedVertices = 0;
+        std::mt19937 updateRandom(54321);
+
+        // ALT: preprocessing, then the same random queries answered by A* and by spp_dijkstra
+        AltShortestPaths::Selection landmarkSelection =
+            landmarkSelect == 0 ? AltShortestPaths::Selection::Farthest : AltShortestPaths::Selection::Avoid;
+        std::vector<double> altPreprocessTimes;
+        std::vector<double> altQueryTimes;
+        std::vector<double> dijkstraQueryTimes;
+        double altMemoryBytes = 0.0;
+        long long altSettled = 0;
+        long long altMismatches = 0;
+
+        // Contraction hierarchies: same query setup as ALT, paths are also unpacked and checked
+        std::vector<double> chPreprocessTimes;
+        std::vector<double> chQueryTimes;
+        double chMemoryBytes = 0.0;
+        long long chShortcuts = 0;
+        long long chSettled = 0;
+        long long chMismatches = 0;
+        long long chPathErrors = 0;
+
+        // Baseline of the point-to-point engines: random queries, one spp_dijkstra_list each.
+        // The path is walked too, so the work compared is the same.
+        auto dijkstraQueries = [&](Graph& graph, std::vector<std::pair<Index, Index>>& queries, std::vector<Distance>& expected) {
+            std::uniform_int_distribution<long long> vertex(0, size - 1);
+            queries.resize(std::max(0, queryCount));
+            for (auto& query : queries) {
+                query = { (Index)vertex(queryRandom), (Index)vertex(queryRandom) };
+            }
+            expected.resize(queries.size());
+
+            std::vector<Index> path;
+            timer.reset();
+            timer.start();
+            for (size_t q = 0; q < queries.size(); q++) {
+                graph.spp_dijkstra_list(queries[q].first, workspace);
+                Index target = graph.toInternal(queries[q].second);
+                path.clear();
+                if (workspace.distance[target] < INFINITE_DISTANCE) {
+                    for (Index v = target; v != NO_INDEX; v = workspace.previous[v]) {
+                        path.push_back(graph.toOriginal(v));
+                    }
+                }
+                expected[q] = workspace.distance[target];
+            }
+            timer.stop();
+            double resultDijkstra = timer.resultNs() / 1e6;
+            dijkstraQueryTimes.push_back(resultDijkstra);
+            outFile << "Queries_Dijkstra: " << resultDijkstra << "\n";
+        };
+
+        // Generators 1-3 fill the edge array straight from the generator
+        Index edgeTarget = degree > 0 ? (Index)size * degree / (directed ? 1 : 2)
+                                      : GraphGenerator::edgesForDensity(size, density, directed);
+        std::random_device randomSeed;
 
         for (int i = 0; i < count; i++) {
             Graph graph;
-            graph.generateRandomGraph(size, density, directed);
+            unsigned graphSeed = seed != 0 ? (unsigned)seed + i : 0;
+            if (generatorKind == 0) {
+                graph.generateRandomGraph(size, density, directed, graphSeed);
+            }
+            else {
+                graph.generate(GraphGenerator((GraphGenerator::Kind)(generatorKind - 1), size, edgeTarget, directed,
+                                              graphSeed != 0 ? graphSeed : randomSeed(), (Weight)graph.MAX_WEIGHT));
+            }
 
             if (problem == 0) { // MST
                 if (algorithm == 0 || algorithm == 1) { // Prim's
                     timer.reset();
                     timer.start();
-                    graph.mst_prim_matrix();
+                    graph.mst_prim_matrix(workspace);
                     timer.stop();
                     double resultMatrix = timer.result();
                     primTimesMatrix.push_back(resultMatrix);
@@ -301,7 +631,7 @@ int main(int argc, char* argv[]) {
 
                     timer.reset();
                     timer.start();
-                    graph.mst_prim_list();
+                    graph.mst_prim_list(workspace);
                     timer.stop();
                     double resultList = timer.result();
                     primTimesList.push_back(resultList);
@@ -310,7 +640,7 @@ int main(int argc, char* argv[]) {
                 if (algorithm == 0 || algorithm == 2) { // Kruskal's
                     timer.reset();
                     timer.start();
-                    graph.mst_kruskal_matrix();
+                    graph.mst_kruskal_matrix(workspace);
                     timer.stop();
                     double resultMatrix = timer.result();
                     kruskalTimesMatrix.push_back(resultMatrix);
@@ -318,20 +648,89 @@ int main(int argc, char* argv[]) {
 
                     timer.reset();
                     timer.start();
-                    graph.mst_kruskal_list();
+                    graph.mst_kruskal_list(workspace);
                     timer.stop();
                     double resultList = timer.result();
                     kruskalTimesList.push_back(resultList);
                     outFile << "Kruskal_List: " << resultList << "\n";
                 }
+                if (algorithm == 4) { // Incremental MST
+                    DynamicMST dynamicTree;
+                    dynamicTree.build(graph);
+                    std::uniform_int_distribution<int> weight(1, graph.MAX_WEIGHT);
+                    std::uniform_int_distribution<int> kind(0, 2);
+
+                    for (int u = 0; u < updateCount; u++) {
+                        // 0 - new edge, 1 - lighter edge, 2 - heavier edge
+                        int updateKind = kind(updateRandom);
+                        Index v1, v2;
+                        Weight newWeight = (Weight)weight(updateRandom);
+                        if (updateKind == 0 && !pickFreePair(graph, updateRandom, v1, v2)) {
+                            updateKind = 2; // No free pair left, change a weight instead
+                        }
+                        if (updateKind != 0) {
+                            Edge edge = graph.edgeAt(std::uniform_int_distribution<Index>(0, graph.getSize() - 1)(updateRandom));
+                            v1 = edge.v1;
+                            v2 = edge.v2;
+                            if (updateKind == 1) {
+                                newWeight = (Weight)std::max(1, (int)(edge.weight / 2));
+                            }
+                            else {
+                                // Clamped so that narrow weight types do not wrap to a lighter edge
+                                newWeight = (Weight)std::min<double>((double)edge.weight + newWeight,
+                                                                     (double)std::numeric_limits<Weight>::max());
+                            }
+                        }
+
+                        timer.reset();
+                        timer.start();
+                        if (updateKind == 0) {
+                            dynamicTree.insertEdge(graph, v1, v2, newWeight);
+                        }
+                        else {
+                            dynamicTree.changeWeight(graph, v1, v2, newWeight);
+                        }
+                        timer.stop();
+                        double resultIncremental = timer.resultNs() / 1e3;
+                        incrementalUpdateTimes.push_back(resultIncremental);
+
+                        // Baseline: the graph is already updated, only the MST is recomputed
+                        timer.reset();
+                        timer.start();
+                        graph.mst_kruskal_list(workspace);
+                        timer.stop();
+                        double resultRerun = timer.resultNs() / 1e3;
+                        rerunUpdateTimes.push_back(resultRerun);
+                        outFile << "Update_Incremental_us: " << resultIncremental << " Update_Rerun_us: " << resultRerun << "\n";
+
+                        if (workspace.treeWeight() != dynamicTree.weight()) {
+                            updateMismatches++;
+                        }
+                    }
+                }
+                if (algorithm == 3) { // Prim's over every heap
+                    for (int h = 0; h < 4; h++) {
+                        timer.reset();
+                        timer.start();
+                        switch (h) {
+                        case 0: graph.list_rep->mst_prim(workspace, binaryHeap); break;
+                        case 1: graph.list_rep->mst_prim(workspace, fourAryHeap); break;
+                        case 2: graph.list_rep->mst_prim(workspace, eightAryHeap); break;
+                        case 3: graph.list_rep->mst_prim(workspace, pairingHeap); break;
+                        }
+                        timer.stop();
+                        double result = timer.resultNs() / 1e6;
+                        heapTimes[h].push_back(result);
+                        outFile << "Prim_" << heapNames[h] << ": " << result << "\n";
+                    }
+                }
             }
             else if (problem == 1) { // Shortest path
-                int startVertex = 0;
-                int endVertex = size - 1;
+                Index startVertex = 0;
                 if (algorithm == 0 || algorithm == 1) { // Dijkstra's
                     timer.reset();
                     timer.start();
-                    graph.spp_dijkstra_matrix(startVertex, endVertex);
+                    graph.spp_dijkstra_matrix(startVertex, workspace);
                     timer.stop();
                     double resultMatrix = timer.result();
                     dijkstraTimesMatrix.push_back(resultMatrix);
@@ -339,12 +738,289 @@ int main(int argc, char* argv[]) {
 
                     timer.reset();
                     timer.start();
-                    graph.spp_dijkstra_list(startVertex, endVertex);
+                    graph.spp_dijkstra_list(startVertex, workspace);
                     timer.stop();
                     double resultList = timer.result();
                     dijkstraTimesList.push_back(resultList);
                     outFile << "Dijkstra_List: " << resultList << "\n";
                 }
+                if (algorithm == 2) { // All-pairs
+                    // Baseline: one spp_dijkstra call per source vertex
+                    timer.reset();
+                    timer.start();
+                    for (Index source = 0; source < (Index)size; source++) {
+                        graph.spp_dijkstra_list(source, workspace);
+                    }
+                    timer.stop();
+                    double resultRepeated = timer.resultNs() / 1e6;
+                    repeatedDijkstraTimes.push_back(resultRepeated);
+                    outFile << "Repeated_Dijkstra_List: " << resultRepeated << "\n";
+
+                    BatchShortestPaths engine(*graph.list_rep, threads);
+
+                    timer.reset();
+                    timer.start();
+                    DistanceTable* table = engine.allPairs(BatchShortestPaths::Mode::Dijkstra);
+                    timer.stop();
+                    delete table;
+                    double resultBatch = timer.resultNs() / 1e6;
+                    batchDijkstraTimes.push_back(resultBatch);
+                    outFile << "Batch_Dijkstra: " << resultBatch << "\n";
+
+                    timer.reset();
+                    timer.start();
+                    table = engine.allPairs(BatchShortestPaths::Mode::FloydWarshall);
+                    timer.stop();
+                    delete table;
+                    double resultFloyd = timer.resultNs() / 1e6;
+                    floydWarshallTimes.push_back(resultFloyd);
+                    outFile << "Floyd_Warshall: " << resultFloyd << "\n";
+                }
+                if (algorithm == 5) { // Incremental shortest paths
+                    DynamicShortestPaths dynamicPaths;
+                    dynamicPaths.compute(graph, startVertex);
+                    std::uniform_int_distribution<int> weight(1, graph.MAX_WEIGHT);
+
+                    for (int done = 0; done < updateCount; done += updateBatch) {
+                        // Half new edges, half lighter existing ones
+                        for (int u = done; u < std::min(updateCount, done + updateBatch); u++) {
+                            Index v1, v2;
+                            // Without a free pair the new edge becomes a lighter existing one
+                            if (u % 2 == 0 && pickFreePair(graph, updateRandom, v1, v2)) {
+                                dynamicPaths.insertEdge(graph, v1, v2, (Weight)weight(updateRandom));
+                            }
+                            else {
+                                Edge edge = graph.edgeAt(std::uniform_int_distribution<Index>(0, graph.getSize() - 1)(updateRandom));
+                                dynamicPaths.changeWeight(graph, edge.v1, edge.v2, (Weight)std::max(1, (int)(edge.weight / 2)));
+                            }
+                        }
+
+                        // Graph changes are applied above, only the path refresh is timed
+                        timer.reset();
+                        timer.start();
+                        affectedVertices += dynamicPaths.update(graph);
+                        timer.stop();
+                        double resultIncremental = timer.resultNs() / 1e3;
+                        incrementalUpdateTimes.push_back(resultIncremental);
+
+                        timer.reset();
+                        timer.start();
+                        graph.spp_dijkstra_list(startVertex, workspace);
+                        timer.stop();
+                        double resultRerun = timer.resultNs() / 1e3;
+                        rerunUpdateTimes.push_back(resultRerun);
+                        outFile << "Update_Incremental_us: " << resultIncremental << " Update_Rerun_us: " << resultRerun << "\n";
+
+                        const Distance* distances = dynamicPaths.getDistances();
+                        for (Index v = 0; v < graph.getOrder(); v++) {
+                            if (distances[v] != workspace.distance[v]) {
+                                updateMismatches++;
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (algorithm == 3) { // Dijkstra's over every heap
+                    for (int h = 0; h < 4; h++) {
+                        timer.reset();
+                        timer.start();
+                        switch (h) {
+                        case 0: graph.list_rep->spp_dijkstra(startVertex, workspace, binaryHeap); break;
+                        case 1: graph.list_rep->spp_dijkstra(startVertex, workspace, fourAryHeap); break;
+                        case 2: graph.list_rep->spp_dijkstra(startVertex, workspace, eightAryHeap); break;
+                        case 3: graph.list_rep->spp_dijkstra(startVertex, workspace, pairingHeap); break;
+                        }
+                        timer.stop();
+                        double result = timer.resultNs() / 1e6;
+                        heapTimes[h].push_back(result);
+                        outFile << "Dijkstra_" << heapNames[h] << ": " << result << "\n";
+                    }
+                }
+                if (algorithm == 6) { // ALT point-to-point queries
+                    timer.reset();
+                    timer.start();
+                    AltShortestPaths alt(*graph.list_rep, directed, (Index)landmarkCount, landmarkSelection, threads, (unsigned)(i + 1));
+                    timer.stop();
+                    double resultPreprocess = timer.resultNs() / 1e6;
+                    altPreprocessTimes.push_back(resultPreprocess);
+                    altMemoryBytes += (double)alt.memoryBytes();
+                    outFile << "ALT_Preprocess: " << resultPreprocess << "\n";
+
+                    std::vector<std::pair<Index, Index>> queries;
+                    std::vector<Distance> expected;
+                    dijkstraQueries(graph, queries, expected);
+
+                    std::vector<Distance> answers(queries.size());
+                    std::vector<Index> path;
+                    timer.reset();
+                    timer.start();
+                    for (size_t q = 0; q < queries.size(); q++) {
+                        answers[q] = alt.query(graph.toInternal(queries[q].first), graph.toInternal(queries[q].second));
+                        path.resize(alt.pathLength());
+                        alt.extractPath(path.data());
+                        altSettled += alt.lastSettled();
+                    }
+                    timer.stop();
+                    double resultAlt = timer.resultNs() / 1e6;
+                    altQueryTimes.push_back(resultAlt);
+                    outFile << "Queries_ALT: " << resultAlt << "\n";
+
+                    for (size_t q = 0; q < queries.size(); q++) {
+                        if (answers[q] != expected[q]) {
+                            altMismatches++;
+                        }
+                    }
+                }
+                if (algorithm == 7) { // Contraction hierarchies
+                    timer.reset();
+                    timer.start();
+                    ContractionHierarchy hierarchy(*graph.list_rep);
+                    timer.stop();
+                    double resultPreprocess = timer.resultNs() / 1e6;
+                    chPreprocessTimes.push_back(resultPreprocess);
+                    chMemoryBytes += (double)hierarchy.memoryBytes();
+                    chShortcuts += hierarchy.getShortcutCount();
+                    outFile << "CH_Preprocess: " << resultPreprocess << "\n";
+
+                    std::vector<std::pair<Index, Index>> queries;
+                    std::vector<Distance> expected;
+                    dijkstraQueries(graph, queries, expected);
+
+                    std::vector<Distance> answers(queries.size());
+                    std::vector<std::vector<Index>> paths(queries.size());
+                    timer.reset();
+                    timer.start();
+                    for (size_t q = 0; q < queries.size(); q++) {
+                        answers[q] = hierarchy.query(graph.toInternal(queries[q].first), graph.toInternal(queries[q].second));
+                        hierarchy.extractPath(paths[q]);
+                        chSettled += hierarchy.lastSettled();
+                    }
+                    timer.stop();
+                    double resultCh = timer.resultNs() / 1e6;
+                    chQueryTimes.push_back(resultCh);
+                    outFile << "Queries_CH: " << resultCh << "\n";
+
+                    // Distances against spp_dijkstra, unpacked paths against the graph's own arcs
+                    for (size_t q = 0; q < queries.size(); q++) {
+                        if (answers[q] != expected[q]) {
+                            chMismatches++;
+                            continue;
+                        }
+                        const std::vector<Index>& path = paths[q];
+                        if (answers[q] >= INFINITE_DISTANCE) {
+                            chPathErrors += path.empty() ? 0 : 1;
+                            continue;
+                        }
+                        Distance cost = 0;
+                        for (size_t p = 1; p < path.size(); p++) {
+                            Distance lightest = INFINITE_DISTANCE;
+                            for (const AdjacencyList::ListNode* node = graph.list_rep->neighbours(path[p - 1]); node != nullptr; node = node->next) {
+                                if (node->id == path[p] && node->weight < lightest) {
+                                    lightest = node->weight;
+                                }
+                            }
+                            cost += lightest;
+                        }
+                        if (path.empty() || path.front() != graph.toInternal(queries[q].first)
+                            || path.back() != graph.toInternal(queries[q].second) || cost != answers[q]) {
+                            chPathErrors++;
+                        }
+                    }
+                }
+                if (algorithm == 4) { // Point-to-point queries
+                    // Sources repeat - a small pool of random vertices, targets are arbitrary
+                    std::uniform_int_distribution<long long> vertex(0, size - 1);
+                    std::vector<Index> pool(std::max(1, sourceCount));
+                    for (Index& source : pool) {
+                        source = (Index)vertex(queryRandom);
+                    }
+                    std::uniform_int_distribution<size_t> pick(0, pool.size() - 1);
+                    std::vector<std::pair<Index, Index>> queries(std::max(0, queryCount));
+                    for (auto& query : queries) {
+                        query = { pool[pick(queryRandom)], (Index)vertex(queryRandom) };
+                    }
+
+                    // Both variants produce the path, so the work compared is the same
+                    std::vector<Index> path;
+                    std::vector<Distance> expected(queries.size());
+                    std::vector<Distance> answers(queries.size());
+                    timer.reset();
+                    timer.start();
+                    for (size_t q = 0; q < queries.size(); q++) {
+                        graph.spp_dijkstra_list(queries[q].first, workspace);
+                        path.clear();
+                        for (Index v = graph.toInternal(queries[q].second); v != NO_INDEX; v = workspace.previous[v]) {
+                            path.push_back(graph.toOriginal(v));
+                        }
+                        expected[q] = workspace.distance[graph.toInternal(queries[q].second)];
+                    }
+                    timer.stop();
+                    double resultUncached = timer.resultNs() / 1e6;
+                    uncachedQueryTimes.push_back(resultUncached);
+                    outFile << "Queries_Uncached: " << resultUncached << "\n";
+
+                    ShortestPathCache cache((size_t)cacheMB << 20);
+                    timer.reset();
+                    timer.start();
+                    for (size_t q = 0; q < queries.size(); q++) {
+                        const PathResult* tree = cache.tree(graph, queries[q].first);
+                        path.resize(tree->pathLength(queries[q].second));
+                        tree->extractPath(queries[q].second, path.data());
+                        answers[q] = tree->distance[queries[q].second];
+                    }
+                    timer.stop();
+                    double resultCached = timer.resultNs() / 1e6;
+                    cachedQueryTimes.push_back(resultCached);
+                    outFile << "Queries_Cached: " << resultCached << "\n";
+
+                    for (size_t q = 0; q < queries.size(); q++) {
+                        if (answers[q] != expected[q]) {
+                            cacheMismatches++;
+                        }
+                        else if (expected[q] >= INFINITE_DISTANCE) {
+                            cacheUnreachable++;
+                        }
+                    }
+                    cacheHits += cache.hits;
+                    cacheMisses += cache.misses;
+                    cacheEvictions += cache.evictions;
+                }
+            }
+
+            if (reorder != VertexOrdering::Kind::Original) {
+                // One untimed run first, so that freshly built lists are not measured cold
+                auto runList = [&]() {
+                    for (int run = 0; run < 2; run++) {
+                        timer.reset();
+                        timer.start();
+                        if (problem == 0) {
+                            graph.mst_prim_list(workspace);
+                        }
+                        else {
+                            graph.spp_dijkstra_list(0, workspace);
+                        }
+                        timer.stop();
+                    }
+                    return timer.resultNs() / 1e6;
+                };
+
+                double resultOriginal = runList();
+                originalOrderTimes.push_back(resultOriginal);
+                outFile << "Original_Order_List: " << resultOriginal << "\n";
+
+                bandwidthBefore += graph.bandwidth();
+                timer.reset();
+                timer.start();
+                graph.reorder(reorder);
+                timer.stop();
+                double resultReorder = timer.resultNs() / 1e6;
+                bandwidthAfter += graph.bandwidth();
+                reorderTimes.push_back(resultReorder);
+                outFile << "Reorder_" << VertexOrdering::name(reorder) << ": " << resultReorder << "\n";
+
+                double resultReordered = runList();
+                reorderedTimes.push_back(resultReordered);
+                outFile << "Reordered_List: " << resultReordered << "\n";
             }
 
             std::cout << "Completed test " << (i + 1) << "/" << count << "\n";
@@ -353,27 +1029,6 @@ int main(int argc, char* argv[]) {
         outFile << "\n=== STATISTICS ===\n";
         std::cout << "\n=== STATISTICS ===\n";
 
-        // Helper function to calculate average
-        auto calculateAverage = [](const std::vector<double>& times) -> double {
-            if (times.empty()) return 0.0;
-            double sum = 0.0;
-            for (double t : times) {
-                sum += t;
-            }
-            return sum / times.size();
-        };
-
-        // Helper function to calculate standard deviation
-        auto calculateStdDev = [](const std::vector<double>& times, double avg) -> double {
-            if (times.empty() || times.size() == 1) return 0.0;
-            double sumSquaredDiff = 0.0;
-            for (double t : times) {
-                double diff = t - avg;
-                sumSquaredDiff += diff * diff;
-            }
-            return std::sqrt(sumSquaredDiff / times.size());
-        };
-
         // Print statistics for each algorithm and representation
         if (!primTimesMatrix.empty() || !primTimesList.empty()) {
             outFile << "Prim's Algorithm:\n";
@@ -456,11 +1111,360 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        if (!batchDijkstraTimes.empty()) {
+            outFile << "All-pairs shortest paths (" << threads << " threads, 0 = all):\n";
+            std::cout << "All-pairs shortest paths (" << threads << " threads, 0 = all):\n";
+            printSeries(outFile, "Repeated spp_dijkstra (List)", repeatedDijkstraTimes);
+            printSeries(outFile, "Batched Dijkstra", batchDijkstraTimes);
+            printSeries(outFile, "Blocked Floyd-Warshall", floydWarshallTimes);
+        }
+
+        if (!heapTimes[0].empty()) {
+            const char* algorithmName = (problem == 0) ? "Prim's" : "Dijkstra's";
+            outFile << algorithmName << " Algorithm by priority queue (List Representation):\n";
+            std::cout << algorithmName << " Algorithm by priority queue (List Representation):\n";
+            for (int h = 0; h < 4; h++) {
+                printSeries(outFile, std::string(heapNames[h]) + " heap", heapTimes[h]);
+            }
+        }
+
+        if (!incrementalUpdateTimes.empty()) {
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                if (problem == 0) {
+                    *out << "Dynamic MST (" << updateCount << " updates per graph, times in us):\n";
+                }
+                else {
+                    *out << "Dynamic shortest paths (" << updateCount << " updates per graph in batches of "
+                         << updateBatch << ", times in us per batch):\n";
+                }
+            }
+            // printSeries labels its values as ms, so the numbers are printed here directly
+            double incremental = calculateAverage(incrementalUpdateTimes);
+            double rerun = calculateAverage(rerunUpdateTimes);
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                *out << std::fixed << std::setprecision(3);
+                *out << "  Incremental update: " << incremental << " us (std dev "
+                     << calculateStdDev(incrementalUpdateTimes, incremental) << ")\n";
+                *out << (problem == 0 ? "  Full Kruskal rerun: " : "  Full Dijkstra rerun: ") << rerun << " us (std dev "
+                     << calculateStdDev(rerunUpdateTimes, rerun) << ")\n";
+                *out << "  Speedup: " << (incremental > 0.0 ? rerun / incremental : 0.0) << "x, "
+                     << (problem == 0 ? "weight" : "distance") << " mismatches: " << updateMismatches << "\n";
+                if (problem == 1) {
+                    *out << "  Vertices re-settled per batch: " << std::setprecision(1)
+                         << (double)affectedVertices / incrementalUpdateTimes.size() << " of " << size << "\n";
+                }
+            }
+        }
+
+        if (!cachedQueryTimes.empty()) {
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                *out << "Point-to-point queries (" << queryCount << " per graph, " << sourceCount
+                     << " sources, cache " << cacheMB << " MB):\n";
+            }
+            printSeries(outFile, "Dijkstra per query", uncachedQueryTimes);
+            printSeries(outFile, "Path tree cache", cachedQueryTimes);
+            double lookups = (double)(cacheHits + cacheMisses);
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                *out << "  Cache hits: " << cacheHits << ", misses: " << cacheMisses
+                     << ", evictions: " << cacheEvictions << ", hit rate: " << std::fixed << std::setprecision(1)
+                     << (lookups > 0 ? 100.0 * cacheHits / lookups : 0.0) << "%\n";
+                *out << "  Distance mismatches: " << cacheMismatches << ", unreachable targets: " << cacheUnreachable << "\n";
+            }
+        }
+
+        if (!altQueryTimes.empty()) {
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                *out << "ALT point-to-point queries (" << queryCount << " per graph, " << landmarkCount
+                     << " landmarks, " << AltShortestPaths::name(landmarkSelection) << " selection, "
+                     << threads << " threads, 0 = all):\n";
+            }
+            printSeries(outFile, "Preprocessing", altPreprocessTimes);
+            printSeries(outFile, "spp_dijkstra per query", dijkstraQueryTimes);
+            printSeries(outFile, "ALT A*", altQueryTimes);
+
+            double dijkstra = calculateAverage(dijkstraQueryTimes);
+            double alt = calculateAverage(altQueryTimes);
+            double preprocess = calculateAverage(altPreprocessTimes);
+            double queriesRun = (double)altQueryTimes.size() * std::max(1, queryCount);
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                *out << "  Memory (landmark tables and graph): " << std::fixed << std::setprecision(1)
+                     << altMemoryBytes / altQueryTimes.size() / 1024.0 << " KB\n";
+                *out << "  Vertices settled per query: " << altSettled / queriesRun << " of " << size << "\n";
+                *out << "  Speedup: " << std::setprecision(3) << (alt > 0.0 ? dijkstra / alt : 0.0) << "x";
+                if (dijkstra > alt) {
+                    *out << " (preprocessing repaid after " << std::setprecision(0)
+                         << preprocess / ((dijkstra - alt) / std::max(1, queryCount)) << " queries)";
+                }
+                *out << ", distance mismatches: " << altMismatches << "\n";
+            }
+        }
+
+        if (!chQueryTimes.empty()) {
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                *out << "Contraction hierarchies (" << queryCount << " queries per graph):\n";
+            }
+            printSeries(outFile, "Preprocessing", chPreprocessTimes);
+            printSeries(outFile, "spp_dijkstra per query", dijkstraQueryTimes);
+            printSeries(outFile, "CH bidirectional upward search", chQueryTimes);
+
+            double dijkstra = calculateAverage(dijkstraQueryTimes);
+            double ch = calculateAverage(chQueryTimes);
+            double preprocess = calculateAverage(chPreprocessTimes);
+            double graphs = (double)chQueryTimes.size();
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                *out << "  Shortcuts: " << std::fixed << std::setprecision(1) << chShortcuts / graphs
+                     << ", memory (upward graphs): " << chMemoryBytes / graphs / 1024.0 << " KB\n";
+                *out << "  Vertices settled per query: " << chSettled / (graphs * std::max(1, queryCount))
+                     << " of " << size << "\n";
+                *out << "  Speedup: " << std::setprecision(3) << (ch > 0.0 ? dijkstra / ch : 0.0) << "x";
+                if (dijkstra > ch) {
+                    *out << " (preprocessing repaid after " << std::setprecision(0)
+                         << preprocess / ((dijkstra - ch) / std::max(1, queryCount)) << " queries)";
+                }
+                *out << "\n  Distance mismatches: " << chMismatches << ", invalid unpacked paths: " << chPathErrors << "\n";
+            }
+        }
+
+        if (!reorderTimes.empty()) {
+            const char* algorithmName = (problem == 0) ? "Prim's" : "Dijkstra's";
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                *out << "Vertex reordering (" << VertexOrdering::name(reorder) << ", "
+                     << algorithmName << " Algorithm, List Representation):\n";
+            }
+            printSeries(outFile, "Reorder cost", reorderTimes);
+            printSeries(outFile, "Original numbering", originalOrderTimes);
+            printSeries(outFile, "Reordered", reorderedTimes);
+
+            double before = calculateAverage(originalOrderTimes);
+            double after = calculateAverage(reorderedTimes);
+            double cost = calculateAverage(reorderTimes);
+            for (std::ostream* out : { (std::ostream*)&outFile, (std::ostream*)&std::cout }) {
+                *out << "  Average bandwidth: " << std::fixed << std::setprecision(1)
+                     << bandwidthBefore / count << " -> " << bandwidthAfter / count << "\n";
+                *out << "  Speedup: " << std::fixed << std::setprecision(3)
+                     << (after > 0.0 ? before / after : 0.0) << "x";
+                if (before > after) {
+                    *out << " (reorder cost repaid after " << std::setprecision(1)
+                         << cost / (before - after) << " runs)";
+                }
+                *out << "\n";
+            }
+        }
+
         outFile.close();
         std::cout << "\nBenchmark complete. Results saved to: " << outputFile << "\n";
     }
+    // BATCH QUERY MODE
+    else if (mode == "--batch") {
+        if (argc < 5) {
+            std::cerr << "Error: Insufficient arguments for --batch mode.\n";
+            showHelp();
+            return 1;
+        }
+        std::string inputFile = argv[2];
+        std::string queryFile = argv[3];
+        std::string outputFile = argv[4];
+        int threads = intOption(argc, argv, 5, "--threads", 0);
+        bool directed = intOption(argc, argv, 5, "--directed", 1) != 0;
+        int reorderKind = intOption(argc, argv, 5, "--reorder", 0);
+        if (reorderKind < 0 || reorderKind > 3) {
+            std::cerr << "Error: Invalid vertex order. Use 0 (none), 1 (BFS), 2 (RCM) or 3 (degree).\n";
+            return 1;
+        }
+
+        Timer timer;
+        timer.reset();
+        timer.start();
+        Graph graph;
+        if (!graph.loadFromFile(inputFile)) {
+            return 1;
+        }
+        graph.init(directed);
+        graph.reorder((VertexOrdering::Kind)reorderKind);
+        timer.stop();
+        double loadTime = timer.resultNs() / 1e6;
+        if (graph.getOrder() == 0) {
+            std::cerr << "Error: Empty graph, nothing to query.\n";
+            return 1;
+        }
+
+        // Queries are kept in the graph's internal numbering, answers are printed in the original one
+        std::ifstream queryInput(queryFile);
+        long long declaredQueries;
+        if (!queryInput.is_open() || !(queryInput >> declaredQueries) || declaredQueries < 0) {
+            std::cerr << "Error: Could not read query count from: " << queryFile << "\n";
+            return 1;
+        }
+        std::vector<PathQuery> queries;
+        queries.reserve((size_t)declaredQueries);
+        for (long long q = 0; q < declaredQueries; q++) {
+            long long vp, vk;
+            if (!(queryInput >> vp >> vk)) {
+                std::cerr << "Error: Invalid query file format at query " << q << "\n";
+                return 1;
+            }
+            if (vp < 0 || vk < 0 || vp >= (long long)graph.getOrder() || vk >= (long long)graph.getOrder()) {
+                std::cerr << "Error: Query " << q << " uses a vertex outside 0.." << graph.getOrder() - 1 << "\n";
+                return 1;
+            }
+            queries.push_back({ graph.toInternal((Index)vp), graph.toInternal((Index)vk) });
+        }
+        queryInput.close();
+
+        std::ofstream outFile(outputFile);
+        if (!outFile.is_open()) {
+            std::cerr << "Error: Failed to open output file: " << outputFile << "\n";
+            return 1;
+        }
+
+        timer.reset();
+        timer.start();
+        BatchShortestPaths engine(*graph.list_rep, threads);
+        timer.stop();
+        double buildTime = timer.resultNs() / 1e6;
+
+        // Each group is formatted by its worker and written in one piece
+        std::mutex outputLock;
+        long long unreachable = 0;
+        timer.reset();
+        timer.start();
+        Index groups = engine.answerQueries(queries.data(), (Index)queries.size(),
+            [&](const Index* group, Index length, const Distance* distance, const Index* previous) {
+                std::string text;
+                std::vector<Index> path;
+                long long missing = 0;
+                for (Index i = 0; i < length; i++) {
+                    const PathQuery& query = queries[group[i]];
+                    text += std::to_string(group[i]) + " " + std::to_string(graph.toOriginal(query.source))
+                        + " " + std::to_string(graph.toOriginal(query.target));
+                    if (distance[query.target] >= INFINITE_DISTANCE) {
+                        text += " unreachable\n";
+                        missing++;
+                        continue;
+                    }
+                    path.clear();
+                    for (Index v = query.target; v != NO_INDEX; v = previous[v]) {
+                        path.push_back(v);
+                    }
+                    text += " " + formatNumber(distance[query.target]);
+                    for (auto v = path.rbegin(); v != path.rend(); ++v) {
+                        text += " " + std::to_string(graph.toOriginal(*v));
+                    }
+                    text += "\n";
+                }
+                std::lock_guard<std::mutex> lock(outputLock);
+                outFile << text;
+                unreachable += missing;
+            });
+        outFile.flush();
+        timer.stop();
+        double queryTime = timer.resultNs() / 1e6;
+        outFile.close();
+
+        double seconds = queryTime / 1e3;
+        std::cout << "\n=== Batch Shortest Paths ===\n";
+        std::cout << "Throughput: " << std::fixed << std::setprecision(0)
+                  << (seconds > 0.0 ? queries.size() / seconds : 0.0) << " queries/s\n";
+        std::cout << "Queries: " << queries.size() << " (" << groups << " distinct sources, "
+                  << unreachable << " unreachable), threads: " << engine.getThreads() << "\n";
+        std::cout << std::setprecision(3) << "Graph load: " << loadTime << " ms, engine build: " << buildTime
+                  << " ms, queries: " << queryTime << " ms\n";
+        std::cout << "Results saved to: " << outputFile << "\n";
+    }
+    // GENERATOR MODE
+    else if (mode == "--generate") {
+        if (argc < 6) {
+            std::cerr << "Error: Insufficient arguments for --generate mode.\n";
+            showHelp();
+            return 1;
+        }
+        int kind = std::stoi(argv[2]);
+        Index size = (Index)std::stoll(argv[3]);
+        int density = std::stoi(argv[4]);
+        std::string outputFile = argv[5];
+        bool directed = intOption(argc, argv, 6, "--directed", 1) != 0;
+        int seed = intOption(argc, argv, 6, "--seed", 0);
+        int degree = intOption(argc, argv, 6, "--degree", 0);
+        if (kind < 1 || kind > 3) {
+            std::cerr << "Error: Invalid generator. Use 1 (R-MAT), 2 (grid) or 3 (geometric).\n";
+            return 1;
+        }
+
+        std::ofstream outFile(outputFile);
+        if (!outFile.is_open()) {
+            std::cerr << "Error: Failed to open output file: " << outputFile << "\n";
+            return 1;
+        }
+
+        Index edgeTarget = degree > 0 ? size * (Index)degree / (directed ? 1 : 2)
+                                      : GraphGenerator::edgesForDensity(size, density, directed);
+        GraphGenerator generator((GraphGenerator::Kind)(kind - 1), size, edgeTarget, directed,
+                                 seed != 0 ? (unsigned)seed : std::random_device()());
+
+        // The header needs the edge count, so the generator runs twice instead of keeping the edges
+        Timer timer;
+        timer.reset();
+        timer.start();
+        Index edges = generator.countEdges();
+        outFile << edges << " " << size << "\n";
+        generator.generate([&](Index v1, Index v2, Weight weight) {
+            outFile << v1 << ' ' << v2 << ' ' << +weight << '\n';
+        });
+        outFile.close();
+        timer.stop();
+
+        std::cout << "Generated " << GraphGenerator::name(generator.getKind()) << " graph: " << size << " vertices, "
+                  << edges << (directed ? " arcs" : " edges") << " in " << timer.resultNs() / 1e6 << " ms\n";
+        std::cout << "Results saved to: " << outputFile << "\n";
+    }
+    // SERVER MODE
+    else if (mode == "--server") {
+        bool random = argc >= 3 && std::string(argv[2]) == "--random";
+        int first = random ? 5 : 3;
+        if (argc < first) {
+            std::cerr << "Error: Insufficient arguments for --server mode.\n";
+            showHelp();
+            return 1;
+        }
+        bool directed = intOption(argc, argv, first, "--directed", 1) != 0;
+        int reorderKind = intOption(argc, argv, first, "--reorder", 0);
+        std::string socketPath = stringOption(argc, argv, first, "--socket", "");
+        int cacheMB = intOption(argc, argv, first, "--cache", 0);
+        if (reorderKind < 0 || reorderKind > 3) {
+            std::cerr << "Error: Invalid vertex order. Use 0 (none), 1 (BFS), 2 (RCM) or 3 (degree).\n";
+            return 1;
+        }
+
+        // Status messages go to stderr, stdout carries only the answers
+        Timer timer;
+        timer.reset();
+        timer.start();
+        Graph graph;
+        if (random) {
+            graph.generateRandomGraph(std::stoi(argv[3]), std::stoi(argv[4]), directed);
+        }
+        else {
+            if (!graph.loadFromFile(argv[2])) {
+                return 1;
+            }
+            graph.init(directed);
+        }
+        if (graph.getOrder() == 0) {
+            std::cerr << "Error: Empty graph, nothing to serve.\n";
+            return 1;
+        }
+        graph.reorder((VertexOrdering::Kind)reorderKind);
+        timer.stop();
+        std::cerr << "Graph ready: " << graph.getOrder() << " vertices, " << graph.getSize() << " edges, "
+                  << (directed ? "directed" : "undirected") << " (" << timer.resultNs() / 1e6 << " ms)\n";
+
+        QueryServer server(graph, directed, (size_t)std::max(cacheMB, 0) << 20);
+        int status = socketPath.empty() ? server.serveStream(std::cin, std::cout) : server.serveSocket(socketPath);
+        server.printSummary(std::cerr);
+        return status;
+    }
     else {
-        std::cerr << "Error: Invalid mode. Use --file, --test, or --help.\n";
+        std::cerr << "Error: Invalid mode. Use --file, --test, --batch, --server, --generate, or --help.\n";
         showHelp();
         return 1;
     }
@@ -0,0 +1,228 @@
+#include "GraphGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+	//splitmix64 - losowe wartosci zalezne tylko od (ziarno, wierzcholek, rodzaj), wiec siatka
+	//nie musi pamietac polozen wierzcholkow ani decyzji o krawedziach
+	unsigned long long mix(unsigned long long x)
+	{
+		x += 0x9E3779B97F4A7C15ULL;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+		return x ^ (x >> 31);
+	}
+
+	//liczba z [0, 1)
+	double unit(unsigned long long seed, Index v, unsigned salt)
+	{
+		return (mix(seed ^ mix(((unsigned long long)v << 3) | salt)) >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	const double RMAT_A = 0.57;
+	const double RMAT_B = 0.19;
+	const double RMAT_C = 0.19;
+
+	const double GRID_JITTER = 0.35;	//przesuniecie wierzcholka wzgledem wezla siatki
+	const double GRID_DROP = 0.15;	//czesc usuwanych krawedzi pionowych
+	const double GRID_DIAGONAL = 0.05;	//czesc wezlow z przekatna w prawo w dol
+	const double GRID_LONGEST = 2.0;	//dlugosc odpowiadajaca maksymalnej wadze
+}
+
+GraphGenerator::GraphGenerator(Kind kind, Index order, Index edges, bool directed, unsigned long long seed, Weight maxWeight)
+	: kind(kind), order(order), edges(edges), directed(directed), seed(seed), max_weight(maxWeight)
+{
+}
+
+Index GraphGenerator::edgesForDensity(Index order, int density, bool directed)
+{
+	Index size = (Index)ceil((double)density * order * (order - 1) / 100);
+	return directed ? size : size / 2;
+}
+
+const char* GraphGenerator::name(Kind kind)
+{
+	switch (kind) {
+	case Kind::RMat: return "R-MAT";
+	case Kind::Grid: return "grid";
+	default: return "geometric";
+	}
+}
+
+Index GraphGenerator::generate(const EdgeSink& sink) const
+{
+	if (order < 2) {
+		return 0;
+	}
+	switch (kind) {
+	case Kind::RMat: return rmat(sink);
+	case Kind::Grid: return grid(sink);
+	default: return geometric(sink);
+	}
+}
+
+Index GraphGenerator::countEdges() const
+{
+	if (kind == Kind::RMat) {	//dokladnie tyle, ile zamowiono
+		return order < 2 ? 0 : edges;
+	}
+	return generate([](Index, Index, Weight) {});
+}
+
+Weight GraphGenerator::lengthWeight(double length, double longest) const
+{
+	double weight = std::round(length / longest * max_weight);
+	return (Weight)std::min<double>(std::max(weight, 1.0), max_weight);
+}
+
+Index GraphGenerator::rmat(const EdgeSink& sink) const
+{
+	std::mt19937_64 random(seed);
+	std::uniform_real_distribution<double> quadrant(0.0, 1.0);
+	std::uniform_int_distribution<int> weight(1, (int)max_weight);
+
+	unsigned scale = 0;
+	while ((1ULL << scale) < order) {
+		scale++;
+	}
+
+	//bez wymieszania wierzcholki o duzym stopniu mialyby najmniejsze numery
+	std::vector<Index> label(order);
+	for (Index v = 0; v < order; v++) {
+		label[v] = v;
+	}
+	for (Index v = order - 1; v > 0; v--) {
+		std::swap(label[v], label[std::uniform_int_distribution<Index>(0, v)(random)]);
+	}
+
+	//kazdy bit numerow wybiera jedna czwiartke macierzy sasiedztwa; pary spoza zakresu
+	//(order nie musi byc potega dwojki) i petle losowane sa od nowa
+	for (Index e = 0; e < edges; e++) {
+		unsigned long long u, v;
+		do {
+			u = 0;
+			v = 0;
+			for (unsigned bit = 0; bit < scale; bit++) {
+				double r = quadrant(random);
+				if (r >= RMAT_A + RMAT_B + RMAT_C) {
+					u |= 1ULL << bit;
+					v |= 1ULL << bit;
+				}
+				else if (r >= RMAT_A + RMAT_B) {
+					u |= 1ULL << bit;
+				}
+				else if (r >= RMAT_A) {
+					v |= 1ULL << bit;
+				}
+			}
+		} while (u >= order || v >= order || u == v);
+		sink(label[u], label[v], (Weight)weight(random));
+	}
+	return edges;
+}
+
+Index GraphGenerator::grid(const EdgeSink& sink) const
+{
+	Index width = (Index)std::ceil(std::sqrt((double)order));
+	Index count = 0;
+
+	auto position = [&](Index v, double& x, double& y) {
+		x = (double)(v % width) + (unit(seed, v, 0) * 2.0 - 1.0) * GRID_JITTER;
+		y = (double)(v / width) + (unit(seed, v, 1) * 2.0 - 1.0) * GRID_JITTER;
+	};
+	auto road = [&](Index v, Index u) {
+		double vx, vy, ux, uy;
+		position(v, vx, vy);
+		position(u, ux, uy);
+		Weight weight = lengthWeight(std::hypot(vx - ux, vy - uy), GRID_LONGEST);
+		sink(v, u, weight);
+		count++;
+		if (directed) {
+			sink(u, v, weight);
+			count++;
+		}
+	};
+
+	for (Index v = 0; v < order; v++) {
+		Index x = v % width;
+		if (x + 1 < width && v + 1 < order) {
+			road(v, v + 1);
+		}
+		if (v + width < order && (x == 0 || unit(seed, v, 2) >= GRID_DROP)) {
+			road(v, v + width);
+		}
+		if (x + 1 < width && v + width + 1 < order && unit(seed, v, 3) < GRID_DIAGONAL) {
+			road(v, v + width + 1);
+		}
+	}
+	return count;
+}
+
+Index GraphGenerator::geometric(const EdgeSink& sink) const
+{
+	//promien, przy ktorym oczekiwana liczba par (bez efektu brzegu) to zadana liczba krawedzi
+	const double pi = 3.14159265358979323846;
+	double pairs = directed ? edges / 2.0 : (double)edges;
+	double radius = std::sqrt(2.0 * pairs / (pi * (double)order * (order - 1)));
+	radius = std::min(std::max(radius, 1e-9), std::sqrt(2.0));
+
+	//komorki o boku >= promien - sasiedzi punktu leza w jego komorce i osmiu wokol
+	Index side = (Index)std::min(1.0 / radius, std::ceil(std::sqrt((double)order)));
+	side = std::max<Index>(side, 1);
+	std::vector<double> px(order), py(order);
+	std::vector<Index> cell_start((size_t)side * side + 1, 0);
+	std::vector<Index> members(order);
+	auto cellOf = [&](Index v) {
+		Index cx = std::min<Index>((Index)(px[v] * side), side - 1);
+		Index cy = std::min<Index>((Index)(py[v] * side), side - 1);
+		return (size_t)cy * side + cx;
+	};
+	for (Index v = 0; v < order; v++) {
+		px[v] = unit(seed, v, 0);
+		py[v] = unit(seed, v, 1);
+		cell_start[cellOf(v) + 1]++;
+	}
+	for (size_t c = 0; c + 1 < cell_start.size(); c++) {
+		cell_start[c + 1] += cell_start[c];
+	}
+	std::vector<Index> pos(cell_start.begin(), cell_start.end() - 1);
+	for (Index v = 0; v < order; v++) {
+		members[pos[cellOf(v)]++] = v;
+	}
+
+	Index count = 0;
+	for (Index cy = 0; cy < side; cy++) {
+		for (Index cx = 0; cx < side; cx++) {
+			size_t cell = (size_t)cy * side + cx;
+			for (Index i = cell_start[cell]; i < cell_start[cell + 1]; i++) {
+				Index v = members[i];
+				for (Index ny = cy > 0 ? cy - 1 : 0; ny <= cy + 1 && ny < side; ny++) {
+					for (Index nx = cx > 0 ? cx - 1 : 0; nx <= cx + 1 && nx < side; nx++) {
+						size_t other = (size_t)ny * side + nx;
+						for (Index j = cell_start[other]; j < cell_start[other + 1]; j++) {
+							Index u = members[j];
+							if (u <= v) {	//kazda para raz
+								continue;
+							}
+							double length = std::hypot(px[v] - px[u], py[v] - py[u]);
+							if (length > radius) {
+								continue;
+							}
+							Weight weight = lengthWeight(length, radius);
+							sink(v, u, weight);
+							count++;
+							if (directed) {
+								sink(u, v, weight);
+								count++;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return count;
+}
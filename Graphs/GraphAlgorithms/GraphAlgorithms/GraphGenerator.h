@@ -0,0 +1,54 @@
+#pragma once
+
+#include <functional>
+#include "GraphTypes.h"
+
+// Generatory grafow o strukturze blizszej rzeczywistym niz Graph::generateRandomGraph:
+//   - RMat: R-MAT / Kronecker (a, b, c, d = 0.57, 0.19, 0.19, 0.05 jak w Graph500) - rozklad
+//     stopni potegowy, kilka wierzcholkow o ogromnym stopniu; numery wierzcholkow wymieszane,
+//     krawedzie wielokrotne zostaja (petle sa losowane od nowa),
+//   - Grid: siatka 2D z zaburzeniami, na wzor sieci drogowej - wierzcholki przesuniete losowo
+//     wzgledem wezlow siatki, waga proporcjonalna do dlugosci, czesc krawedzi pionowych usunieta,
+//     nieliczne przekatne; wszystkie poziome i pierwsza kolumna zostaja, wiec graf jest spojny,
+//   - Geometric: losowy graf geometryczny - punkty w kwadracie jednostkowym, krawedz pomiedzy
+//     punktami blizszymi niz promien dobrany do zadanej liczby krawedzi, waga ~ odleglosc.
+// Generator jest deterministyczny dla danego ziarna i oddaje krawedzie po jednej (EdgeSink),
+// nie trzymajac ich w pamieci - pamiec O(V) niezaleznie od liczby krawedzi, wiec duze grafy mozna
+// zapisywac strumieniowo. Liczba krawedzi znana jest przed generowaniem (countEdges), co pozwala
+// zaalokowac tablice krawedzi grafu (Graph::generate) lub zapisac naglowek pliku.
+// W grafie skierowanym Grid i Geometric oddaja oba luki kazdej drogi/pary punktow.
+class GraphGenerator
+{
+public:
+	enum class Kind { RMat, Grid, Geometric };
+
+	typedef std::function<void(Index v1, Index v2, Weight weight)> EdgeSink;
+
+	//edges - docelowa liczba krawedzi (lukow w grafie skierowanym); Grid ja pomija -
+	//liczbe krawedzi wyznacza siatka (okolo 2 na wierzcholek)
+	GraphGenerator(Kind kind, Index order, Index edges, bool directed, unsigned long long seed, Weight maxWeight = 97);
+
+	//liczba krawedzi dla gestosci w procentach, jak w Graph::generateRandomGraph
+	static Index edgesForDensity(Index order, int density, bool directed);
+
+	Index generate(const EdgeSink& sink) const;	//zwraca liczbe oddanych krawedzi
+	Index countEdges() const;
+
+	Index getOrder() const { return order; }
+	bool isDirected() const { return directed; }
+	Kind getKind() const { return kind; }
+	static const char* name(Kind kind);
+
+private:
+	Kind kind;
+	Index order;
+	Index edges;
+	bool directed;
+	unsigned long long seed;
+	Weight max_weight;
+
+	Index rmat(const EdgeSink& sink) const;
+	Index grid(const EdgeSink& sink) const;
+	Index geometric(const EdgeSink& sink) const;
+	Weight lengthWeight(double length, double unit) const;
+};
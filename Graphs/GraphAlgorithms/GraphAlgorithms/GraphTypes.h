@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+// Typy liczbowe calego stosu grafowego, wybierane przy kompilacji:
+//   Weight   - waga krawedzi (GRAPH_WEIGHT_UINT8/UINT16/INT32/INT64/FLOAT, domyslnie int32),
+//   Index    - numer wierzcholka, krawedzi i luku (GRAPH_INDEX_UINT32/UINT64, domyslnie uint32),
+//   Distance - suma wag na sciezce, szersza od wagi, wiec nie przepelnia sie na duzych grafach.
+// W CMake: -DGRAPH_WEIGHT_TYPE=uint8 -DGRAPH_INDEX_TYPE=uint64 itd.
+#if defined(GRAPH_WEIGHT_UINT8)
+typedef std::uint8_t Weight;
+#define GRAPH_WEIGHT_NAME "uint8"
+#elif defined(GRAPH_WEIGHT_UINT16)
+typedef std::uint16_t Weight;
+#define GRAPH_WEIGHT_NAME "uint16"
+#elif defined(GRAPH_WEIGHT_INT64)
+typedef std::int64_t Weight;
+#define GRAPH_WEIGHT_NAME "int64"
+#elif defined(GRAPH_WEIGHT_FLOAT)
+typedef float Weight;
+#define GRAPH_WEIGHT_NAME "float"
+#else
+typedef std::int32_t Weight;
+#define GRAPH_WEIGHT_NAME "int32"
+#endif
+
+#if defined(GRAPH_INDEX_UINT64)
+typedef std::uint64_t Index;
+#define GRAPH_INDEX_NAME "uint64"
+#else
+typedef std::uint32_t Index;
+#define GRAPH_INDEX_NAME "uint32"
+#endif
+
+typedef std::conditional<std::is_floating_point<Weight>::value, double, std::int64_t>::type Distance;
+
+// Wartownicy zamiast "duzych wartosci" w rodzaju 9999. Odleglosc nieskonczona to
+// polowa zakresu, wiec dodanie do niej wagi (lub drugiej takiej odleglosci) nie przepelnia sie.
+const Distance INFINITE_DISTANCE = std::numeric_limits<Distance>::max() / 2;
+const Index NO_INDEX = std::numeric_limits<Index>::max();	//brak wierzcholka (np. poprzednika)
+
+//wagi czytane sa przez typ szerszy - uint8 wczytany wprost bylby pojedynczym znakiem;
+//wartosc spoza zakresu Weight (np. ujemna dla typu bez znaku) jest bledem, a nie zawinieciem
+inline bool readWeight(std::istream& in, Weight& weight)
+{
+	typename std::conditional<std::is_floating_point<Weight>::value, double, long long>::type value;
+	if (!(in >> value)) {
+		return false;
+	}
+	if (value < std::numeric_limits<Weight>::lowest() || value > std::numeric_limits<Weight>::max()) {
+		return false;
+	}
+	weight = (Weight)value;
+	return true;
+}
+
+//tekst wagi lub odleglosci - uint8 jako liczba, float bez zer dopisywanych przez to_string
+template <typename T>
+std::string formatNumber(T value)
+{
+	std::ostringstream text;
+	text.precision(std::numeric_limits<double>::digits10);
+	text << +value;
+	return text.str();
+}
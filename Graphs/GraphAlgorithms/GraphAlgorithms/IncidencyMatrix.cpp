@@ -1,15 +1,17 @@
 #include "IncidencyMatrix.h"
-#include "VerticeHeap.h"
+#include <limits>
 
 
 
 void IncidencyMatrix::display()
 {
 	std::cout << "Graf w reprezentacji macierzowej: \n";
-	for (int i = 0; i < graph_order; i++) {
+	for (Index i = 0; i < graph_order; i++) {
 		std::cout << i;
-		for (int j = 0; j < graph_size; j++) {
-			std::cout << "  " << pad(std::to_string(incMatrix[i][j]));
+		for (Index j = 0; j < graph_size; j++) {
+			//jak dawniej: waga w komorce, ze znakiem minus przy wierzcholku koncowym
+			std::string cell = incMatrix[i][j] == 0 ? "0" : formatNumber(edgeWeight[j]);
+			std::cout << "  " << pad(incMatrix[i][j] < 0 ? "-" + cell : cell);
 		}
 		std::cout << "\n";
 	}
@@ -29,161 +31,234 @@ std::string IncidencyMatrix::pad(std::string string) {
 	return result;
 }
 
-void IncidencyMatrix::allocate(int size, int order)
+void IncidencyMatrix::allocate(Index size, Index order)
 {
 	deallocate();
 
 	graph_size = size;
 	graph_order = order;
 
-	incMatrix = new int* [graph_order];
-	for (int i = 0; i < graph_order; i++) {
-		incMatrix[i] = new int[graph_size];
-		for (int j = 0; j < graph_size; j++) {
+	incMatrix = new signed char* [graph_order];
+	for (Index i = 0; i < graph_order; i++) {
+		incMatrix[i] = new signed char[graph_size];
+		for (Index j = 0; j < graph_size; j++) {
 			incMatrix[i][j] = 0;
 		}
 	}
+	edgeWeight = new Weight[graph_size];
+	column_capacity = graph_size;
 }
 void IncidencyMatrix::deallocate()
 {
-	for (int i = 0; i < graph_order; i++) {
+	for (Index i = 0; i < graph_order; i++) {
 		delete[] incMatrix[i];
 	}
 	delete[] incMatrix;
+	delete[] edgeWeight;
+	incMatrix = nullptr;
+	edgeWeight = nullptr;
 
 	graph_size = 0;
 	graph_order = 0;
 	last_edge = 0;
+	column_capacity = 0;
 }
 
-void IncidencyMatrix::addEdge(int v1, int v2, int weight, int directed)
+void IncidencyMatrix::addEdge(Index v1, Index v2, Weight weight, int directed)
 {
-	incMatrix[v1][last_edge] = weight;
-	incMatrix[v2][last_edge++] = directed ? -weight : weight;
+	edgeWeight[last_edge] = weight;
+	incMatrix[v1][last_edge] = 1;
+	incMatrix[v2][last_edge++] = directed ? -1 : 1;
+}
+
+void IncidencyMatrix::appendEdge(Index v1, Index v2, Weight weight, int directed)
+{
+	if (graph_size == column_capacity) {
+		Index capacity = column_capacity < 4 ? 8 : column_capacity * 2;
+		for (Index i = 0; i < graph_order; i++) {
+			signed char* row = new signed char[capacity];
+			for (Index j = 0; j < graph_size; j++) {
+				row[j] = incMatrix[i][j];
+			}
+			delete[] incMatrix[i];
+			incMatrix[i] = row;
+		}
+		Weight* weights = new Weight[capacity];
+		for (Index j = 0; j < graph_size; j++) {
+			weights[j] = edgeWeight[j];
+		}
+		delete[] edgeWeight;
+		edgeWeight = weights;
+		column_capacity = capacity;
+	}
+
+	for (Index i = 0; i < graph_order; i++) {
+		incMatrix[i][graph_size] = 0;
+	}
+	graph_size++;
+	addEdge(v1, v2, weight, directed);
 }
 
 List* IncidencyMatrix::mst_kruskal()
 {
-	List* result = new List();
+	Workspace ws;
+	mst_kruskal(ws);
+	return ws.treeToList();
+}
+
+List* IncidencyMatrix::mst_prim()
+{
+	Workspace ws;
+	mst_prim(ws);
+	return ws.treeToList();
+}
+
+PathResult* IncidencyMatrix::spp_dijkstra(Index vp)
+{
+	Workspace ws;
+	spp_dijkstra(vp, ws);
+
+	PathResult* result = new PathResult(graph_order, vp);
+	for (Index i = 0; i < graph_order; i++) {
+		result->distance[i] = ws.distance[i];
+		result->previous[i] = ws.previous[i];
+	}
+	return result;
+}
+
+void IncidencyMatrix::mst_kruskal(Workspace& ws)
+{
+	ws.prepare(graph_order, graph_size);
 
 	//utworzenie kolejki priorytetowej krawdzi
-	EdgeHeap* minEdgeHeap = new EdgeHeap();
-	Edge* e;
+	Edge e;
 	bool first_added;	//flaga oznaczajca, czy ju zosta dodany pierwszy wierzchoek
-	for (int i = 0; i < graph_size; i++) {
-		e = new Edge;
+	for (Index i = 0; i < graph_size; i++) {
+		e = Edge(0, 0, edgeWeight[i]);
 		first_added = false;
-		for (int j = 0; j < graph_order; j++) {
+		for (Index j = 0; j < graph_order; j++) {
 			//jeli w danej komrce nie ma '0' to dodaj wierzchoek
-			if (e->weight = incMatrix[j][i]) {
+			if (incMatrix[j][i] != 0) {
 				if (first_added) {
-					e->v2 = j;
+					e.v2 = j;
+					ws.edge_heap.push(e);
 					break;		//jeli zostay dodane oba wierzchoki mona przej do kolejnej krawdzi
 				}
-				e->v1 = j;
+				e.v1 = j;
 				first_added = true;
 			}
 		}
-		minEdgeHeap->push(e);
 	}
 
 	//zbir rozczny do "kolorowania" odwiedzonych wierzchokw
-	DisjointSets* sets = new DisjointSets(graph_order);
-
-
-	while (minEdgeHeap->heap_length > 0) {
-		e = minEdgeHeap->pop();
-		if (!sets->isOneSet(e->v1, e->v2)) {
-			result->push(e);
-			sets->unionSets(e->v1, e->v2);
+	while (ws.edge_heap.heap_length > 0) {
+		e = ws.edge_heap.pop();
+		if (!ws.sets.isOneSet(e.v1, e.v2)) {
+			ws.addTreeEdge(e.v1, e.v2, e.weight);
+			ws.sets.unionSets(e.v1, e.v2);
 		}
 	}
-
-	return result;
 }
 
-List* IncidencyMatrix::mst_prim()
+//wersja "zachlanna" z jednym kluczem na wierzcholek, jak w liscie sasiedztwa;
+//dla grafu niespojnego zwraca minimalny las rozpinajacy
+void IncidencyMatrix::mst_prim(Workspace& ws)
 {
-	List* result = new List();
-
-	bool* visited = new bool[graph_order] {false};
-	int visitedCount = 0;
-
-	int currentNode = 0;
+	mst_prim(ws, ws.vertex_heap);
+}
 
-	EdgeHeap* minEdgeHeap = new EdgeHeap();
+template <class Heap>
+void IncidencyMatrix::mst_prim(Workspace& ws, Heap& minKeyHeap)
+{
+	ws.prepare(graph_order, 0);
+	minKeyHeap.reserve(graph_order);
+
+	Distance* key = ws.distance;
+	Index* parent = ws.previous;
+	for (Index i = 0; i < graph_order; i++) {
+		key[i] = INFINITE_DISTANCE;
+		parent[i] = NO_INDEX;
+	}
 
-	visited[currentNode] = true;
-	visitedCount++;
+	for (Index root = 0; root < graph_order; root++) {
+		if (ws.isVisited(root)) {
+			continue;
+		}
+		key[root] = 0;
+		minKeyHeap.push(root, 0);
+
+		while (!minKeyHeap.empty()) {
+			Index currentNode = minKeyHeap.pop();
+			ws.markVisited(currentNode);
+			if (parent[currentNode] != NO_INDEX) {
+				ws.addTreeEdge(parent[currentNode], currentNode, (Weight)key[currentNode]);
+			}
 
-	while (visitedCount < graph_order)
-	{
-		for (int i = 0; i < graph_size; i++)
-		{
-			if (incMatrix[currentNode][i] > 0)
-			{
-				for (int j = 0; j < graph_order; j++)
-				{
-					if (j != currentNode && incMatrix[j][i] > 0 && !visited[j])
-					{
-						Edge* e = new Edge();
-						e->v1 = currentNode;
-						e->v2 = j;
-						e->weight = incMatrix[j][i];
-						minEdgeHeap->push(e);
-						break;
+			for (Index i = 0; i < graph_size; i++) {
+				if (incMatrix[currentNode][i] > 0) {
+					for (Index j = 0; j < graph_order; j++) {
+						if (j != currentNode && incMatrix[j][i] > 0) {
+							Weight weight = edgeWeight[i];
+							if (!ws.isVisited(j) && weight < key[j]) {
+								key[j] = weight;
+								parent[j] = currentNode;
+								if (minKeyHeap.contains(j)) {
+									minKeyHeap.decreaseKey(j, weight);
+								}
+								else {
+									minKeyHeap.push(j, weight);
+								}
+							}
+							break;
+						}
 					}
 				}
 			}
 		}
-
-		Edge* e;
-		do {
-			e = minEdgeHeap->pop();
-		} while (visited[e->v2]);
-
-		result->push(e);
-
-		currentNode = e->v2;
-		visited[currentNode] = true;
-		visitedCount++;
 	}
-
-	delete[] visited;
-	return result;
 }
 
 
-std::string IncidencyMatrix::spp_dijkstra(int vp, int vk)
+void IncidencyMatrix::spp_dijkstra(Index vp, Workspace& ws)
 {
-	VerticeHeap* minDistanceHeap = new VerticeHeap();
-	Vertice** vertice = new Vertice * [graph_order];
-
-	Vertice* v;
-	for (int i = 0; i < graph_order; i++) {
-		v = new Vertice;
-		v->id = i;
-		v->previous = nullptr;
-		v->distance = i == vp ? 0 : 9999;	//odlego pocztkowego to 0, reszty "dua warto"
-		minDistanceHeap->push(v);
-		vertice[i] = v;
+	spp_dijkstra(vp, ws, ws.vertex_heap);
+}
+
+template <class Heap>
+void IncidencyMatrix::spp_dijkstra(Index vp, Workspace& ws, Heap& minDistanceHeap)
+{
+	ws.prepare(graph_order, 0);
+	minDistanceHeap.reserve(graph_order);
+
+	for (Index i = 0; i < graph_order; i++) {
+		ws.distance[i] = i == vp ? 0 : INFINITE_DISTANCE;	//odlego pocztkowego to 0, reszty nieskoczona
+		ws.previous[i] = NO_INDEX;
 	}
 
-	int old_dist, new_dist;
-	while (minDistanceHeap->heap_length > 0) {
-		v = minDistanceHeap->pop();
+	minDistanceHeap.push(vp, 0);
 
-		for (int i = 0; i < graph_size; i++) {	//przejcie po macierzy w poszukiwaniu krawdzi wychodzcych z v
-			if (incMatrix[v->id][i] > 0) {
-				for (int j = 0; j < graph_order; j++) {	//znalezienie drugiego wierzchoka
-					if (j != v->id && incMatrix[j][i] < 0) {
+	Index v;
+	Distance old_dist, new_dist;
+	while (!minDistanceHeap.empty()) {
+		v = minDistanceHeap.pop();
 
-						old_dist = vertice[j]->distance;
-						new_dist = v->distance + incMatrix[v->id][i];
+		for (Index i = 0; i < graph_size; i++) {	//przejcie po macierzy w poszukiwaniu krawdzi wychodzcych z v
+			if (incMatrix[v][i] > 0) {
+				for (Index j = 0; j < graph_order; j++) {	//znalezienie drugiego wierzchoka
+					if (j != v && incMatrix[j][i] < 0) {
+
+						old_dist = ws.distance[j];
+						new_dist = ws.distance[v] + edgeWeight[i];
 
 						if (new_dist < old_dist) {	//jeli nowa trasa jest krtsza nastpuje relaksacja
-							vertice[j]->distance = new_dist;
-							vertice[j]->previous = v;
+							ws.distance[j] = new_dist;
+							ws.previous[j] = v;
+							if (minDistanceHeap.contains(j)) {
+								minDistanceHeap.decreaseKey(j, new_dist);
+							}
+							else {
+								minDistanceHeap.push(j, new_dist);
+							}
 						}
 
 						break;
@@ -191,18 +266,15 @@ std::string IncidencyMatrix::spp_dijkstra(int vp, int vk)
 				}
 			}
 		}
-		minDistanceHeap->heapifyDown(0);
 	}
-
-	v = vertice[vk];
-	std::string result;
-	do {
-		result = "[" + std::to_string(v->id) + "] " + result;
-		v = v->previous;
-	} while (v != nullptr);
-
-	v = vertice[vk];
-	result += "\n Calkowity koszt sciezki: " + std::to_string(v->distance);
-
-	return result;
 }
+
+//jawne konkretyzacje dla wszystkich kolejek priorytetowych wierzcholkow
+template void IncidencyMatrix::mst_prim<DaryHeap<2>>(Workspace& ws, DaryHeap<2>& heap);
+template void IncidencyMatrix::mst_prim<DaryHeap<4>>(Workspace& ws, DaryHeap<4>& heap);
+template void IncidencyMatrix::mst_prim<DaryHeap<8>>(Workspace& ws, DaryHeap<8>& heap);
+template void IncidencyMatrix::mst_prim<PairingHeap>(Workspace& ws, PairingHeap& heap);
+template void IncidencyMatrix::spp_dijkstra<DaryHeap<2>>(Index vp, Workspace& ws, DaryHeap<2>& heap);
+template void IncidencyMatrix::spp_dijkstra<DaryHeap<4>>(Index vp, Workspace& ws, DaryHeap<4>& heap);
+template void IncidencyMatrix::spp_dijkstra<DaryHeap<8>>(Index vp, Workspace& ws, DaryHeap<8>& heap);
+template void IncidencyMatrix::spp_dijkstra<PairingHeap>(Index vp, Workspace& ws, PairingHeap& heap);
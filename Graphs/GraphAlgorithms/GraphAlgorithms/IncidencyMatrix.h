@@ -2,9 +2,16 @@
 
 #include "EdgeHeap.h"
 #include "List.h"
+#include "PathResult.h"
+#include "Workspace.h"
+#include "PairingHeap.h"
 #include "DisjointSets.h"
 #include <string>
 
+// Macierz incydencji: komorka [v][e] to 1, gdy krawedz e wychodzi z v (albo - w grafie
+// nieskierowanym - ma v za koniec), -1, gdy do v wchodzi, i 0 w pozostalych przypadkach.
+// Wagi przechowywane sa osobno, po jednej na kolumne, wiec komorka zajmuje jeden bajt
+// niezaleznie od typu wagi (takze bez znaku), a krawedzie o wadze 0 nie znikaja.
 class IncidencyMatrix
 {
 public:
@@ -12,7 +19,9 @@ public:
 		graph_order = 0;
 		graph_size = 0;
 		incMatrix = nullptr;
+		edgeWeight = nullptr;
 		last_edge = 0;
+		column_capacity = 0;
 	};
 
 	~IncidencyMatrix() {
@@ -20,21 +29,35 @@ public:
 	};
 
 	void display();
-	void allocate(int size, int order);
-	void addEdge(int v1, int v2, int weight, int directed);
+	void allocate(Index size, Index order);
+	void addEdge(Index v1, Index v2, Weight weight, int directed);
+	//dopisanie kolumny do gotowej macierzy - wiersze rosna dwukrotnie, wiec zamortyzowane O(V)
+	void appendEdge(Index v1, Index v2, Weight weight, int directed);
+	void setWeight(Index column, Weight weight) { edgeWeight[column] = weight; }
 
 	List* mst_kruskal();
 	List* mst_prim();
 
-	std::string spp_dijkstra(int vp, int vk);
+	PathResult* spp_dijkstra(Index vp);
+
+	//warianty korzystajace z przekazanej pamieci roboczej - wynik zostaje w ws
+	void mst_kruskal(Workspace& ws);
+	void mst_prim(Workspace& ws);
+	void spp_dijkstra(Index vp, Workspace& ws);
+
+	//Prim i Dijkstra nad dowolna kolejka priorytetowa wierzcholkow (DaryHeap<2/4/8>, PairingHeap)
+	template <class Heap> void mst_prim(Workspace& ws, Heap& heap);
+	template <class Heap> void spp_dijkstra(Index vp, Workspace& ws, Heap& heap);
 
 private:
-	int graph_order;
-	int graph_size;
+	Index graph_order;
+	Index graph_size;
 
-	int** incMatrix;
+	signed char** incMatrix;
+	Weight* edgeWeight;	//waga krawedzi z kazdej kolumny
 
-	int last_edge;
+	Index last_edge;
+	Index column_capacity;	//zaalokowane kolumny (>= graph_size)
 
 	void deallocate();
 
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "DaryHeap.h"
+
+// Domyslna kolejka priorytetowa wierzcholkow - indeksowany kopiec binarny.
+typedef DaryHeap<2> IndexedHeap;
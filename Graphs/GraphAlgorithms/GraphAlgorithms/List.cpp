@@ -50,6 +50,17 @@ void List::deleteAll() {
 	}
 }
 
+void List::relabel(const Index* label) {
+
+	if (label == nullptr) {
+		return;
+	}
+	for (ListElement* holder = headPointer; holder != nullptr; holder = holder->next) {
+		holder->edge->v1 = label[holder->edge->v1];
+		holder->edge->v2 = label[holder->edge->v2];
+	}
+}
+
 std::string List::toString() {
 
 	if (headPointer != nullptr) {
@@ -60,7 +71,7 @@ std::string List::toString() {
 		do {
 			result += 
 				" [" + std::to_string(holder->edge->v1) + "-" + std::to_string(holder->edge->v2) +  "] "
-				+ std::to_string(holder->edge->weight) + " ,";
+				+ formatNumber(holder->edge->weight) + " ,";
 			holder = holder->next;
 		} while (holder != nullptr);
 
@@ -69,8 +80,8 @@ std::string List::toString() {
 	return "Lista jest pusta";
 }
 
-int List::sumWeight() {
-	int weight = 0;
+Distance List::sumWeight() {
+	Distance weight = 0;
 	ListElement* holder = headPointer;
 
 	while (holder != nullptr) {
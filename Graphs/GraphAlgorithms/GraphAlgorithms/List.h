@@ -23,8 +23,9 @@ public:
 	Edge* get();
 	void deleteAll();
 
+	void relabel(const Index* label);	//v1, v2 -> label[v1], label[v2]; nullptr - bez zmian
 	std::string toString();
-	int sumWeight();
+	Distance sumWeight();
 
 private:
 	ListElement* headPointer;
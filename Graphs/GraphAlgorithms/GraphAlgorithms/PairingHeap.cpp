@@ -0,0 +1,134 @@
+#include "PairingHeap.h"
+
+void PairingHeap::reserve(Index order)
+{
+	if (order > capacity) {
+		deallocate();
+
+		capacity = order;
+		key = new Distance[capacity];
+		child = new Index[capacity];
+		sibling = new Index[capacity];
+		prev = new Index[capacity];
+		in_heap = new bool[capacity];
+		pairs = new Index[capacity];
+		for (Index i = 0; i < capacity; i++) {
+			in_heap[i] = false;
+		}
+		root = NO_INDEX;
+		heap_length = 0;
+		return;
+	}
+	clear();
+}
+
+void PairingHeap::clear()
+{
+	//wezly nie tworza tablicy, wiec czyszczone sa flagi wszystkich wierzcholkow
+	if (heap_length > 0) {
+		for (Index i = 0; i < capacity; i++) {
+			in_heap[i] = false;
+		}
+	}
+	root = NO_INDEX;
+	heap_length = 0;
+}
+
+void PairingHeap::push(Index v, Distance k)
+{
+	key[v] = k;
+	child[v] = NO_INDEX;
+	sibling[v] = NO_INDEX;
+	prev[v] = NO_INDEX;
+	in_heap[v] = true;
+	heap_length++;
+
+	root = root == NO_INDEX ? v : meld(root, v);
+}
+
+//usuwanie korzenia kopca, zwraca numer wierzcholka
+Index PairingHeap::pop()
+{
+	Index v = root;
+	in_heap[v] = false;
+	heap_length--;
+
+	//pierwszy przebieg - scalanie kolejnych par dzieci od lewej
+	Index count = 0;
+	Index a = child[v];
+	while (a != NO_INDEX) {
+		Index b = sibling[a];
+		if (b == NO_INDEX) {
+			prev[a] = NO_INDEX;
+			pairs[count++] = a;
+			break;
+		}
+		Index next = sibling[b];
+		sibling[a] = prev[a] = NO_INDEX;
+		sibling[b] = prev[b] = NO_INDEX;
+		pairs[count++] = meld(a, b);
+		a = next;
+	}
+
+	//drugi przebieg - dolaczanie par od prawej do jednego drzewa
+	root = NO_INDEX;
+	if (count > 0) {
+		root = pairs[count - 1];
+		for (Index i = count - 1; i > 0; i--) {
+			root = meld(pairs[i - 1], root);
+		}
+	}
+	return v;
+}
+
+void PairingHeap::decreaseKey(Index v, Distance k)
+{
+	key[v] = k;
+	if (v == root) {
+		return;
+	}
+
+	//odciecie poddrzewa v od rodzica lub lewego brata
+	if (child[prev[v]] == v) {
+		child[prev[v]] = sibling[v];
+	}
+	else {
+		sibling[prev[v]] = sibling[v];
+	}
+	if (sibling[v] != NO_INDEX) {
+		prev[sibling[v]] = prev[v];
+	}
+	sibling[v] = NO_INDEX;
+	prev[v] = NO_INDEX;
+
+	root = meld(root, v);
+}
+
+//scalenie dwoch drzew - korzen o wiekszym kluczu staje sie najbardziej lewym dzieckiem drugiego
+Index PairingHeap::meld(Index a, Index b)
+{
+	if (key[b] < key[a]) {
+		Index holder = a;
+		a = b;
+		b = holder;
+	}
+
+	sibling[b] = child[a];
+	if (child[a] != NO_INDEX) {
+		prev[child[a]] = b;
+	}
+	prev[b] = a;
+	child[a] = b;
+	return a;
+}
+
+void PairingHeap::deallocate()
+{
+	delete[] key;
+	delete[] child;
+	delete[] sibling;
+	delete[] prev;
+	delete[] in_heap;
+	delete[] pairs;
+	capacity = 0;
+}
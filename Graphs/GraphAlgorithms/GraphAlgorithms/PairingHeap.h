@@ -0,0 +1,57 @@
+#pragma once
+
+#include "GraphTypes.h"
+
+// Indeksowany kopiec parujacy. Wezlem jest sam wierzcholek - tablice child, sibling
+// i prev maja po jednym polu na wierzcholek, wiec nic nie jest alokowane w trakcie
+// dzialania. Zmniejszenie klucza to odciecie poddrzewa i jedno scalenie z korzeniem
+// (O(1)), caly koszt porzadkowania przenoszony jest do pop() (scalanie dwuprzebiegowe).
+// Interfejs jak w DaryHeap.
+class PairingHeap
+{
+public:
+	PairingHeap() {
+		heap_length = 0;
+		capacity = 0;
+		root = NO_INDEX;
+		key = nullptr;
+		child = nullptr;
+		sibling = nullptr;
+		prev = nullptr;
+		in_heap = nullptr;
+		pairs = nullptr;
+	};
+
+	~PairingHeap() {
+		deallocate();
+	};
+
+	PairingHeap(const PairingHeap&) = delete;
+	PairingHeap& operator=(const PairingHeap&) = delete;
+
+	void reserve(Index order);
+	void clear();
+
+	void push(Index v, Distance k);
+	Index pop();
+	void decreaseKey(Index v, Distance k);
+
+	bool contains(Index v) const { return in_heap[v]; }
+	bool empty() const { return root == NO_INDEX; }
+	Distance topKey() const { return key[root]; }
+
+	Index heap_length;
+
+private:
+	Distance* key;
+	Index* child;		//najbardziej lewe dziecko
+	Index* sibling;	//prawy brat
+	Index* prev;		//lewy brat, a dla najbardziej lewego dziecka - rodzic
+	bool* in_heap;
+	Index* pairs;		//bufor pierwszego przebiegu scalania w pop()
+	Index capacity;
+	Index root;
+
+	Index meld(Index a, Index b);
+	void deallocate();
+};
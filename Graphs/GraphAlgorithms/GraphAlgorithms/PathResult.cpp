@@ -0,0 +1,28 @@
+#include "PathResult.h"
+
+//liczba wierzcholkow na sciezce ze zrodla do vk (0 gdy vk jest nieosiagalny)
+Index PathResult::pathLength(Index vk) const
+{
+	if (!reachable(vk)) {
+		return 0;
+	}
+	Index length = 0;
+	for (Index v = vk; v != NO_INDEX; v = previous[v]) {
+		length++;
+	}
+	return length;
+}
+
+//zapisuje do bufora kolejne wierzcholki sciezki od zrodla do vk, zwraca ich liczbe;
+//bufor musi pomiescic pathLength(vk) elementow
+Index PathResult::extractPath(Index vk, Index* buffer) const
+{
+	Index length = pathLength(vk);
+
+	//wypelnianie od konca - poprzednicy prowadza od vk do zrodla
+	Index i = length;
+	for (Index v = vk; i > 0; v = previous[v]) {
+		buffer[--i] = v;
+	}
+	return length;
+}
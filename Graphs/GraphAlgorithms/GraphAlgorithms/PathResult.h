@@ -0,0 +1,38 @@
+#pragma once
+
+#include "GraphTypes.h"
+
+// Wynik algorytmu najkrotszych sciezek z jednego zrodla: drzewo najkrotszych
+// sciezek zapisane jako tablice odleglosci i poprzednikow (NO_INDEX - brak poprzednika).
+// Sciezka do konkretnego wierzcholka odtwarzana jest dopiero na zadanie.
+class PathResult
+{
+public:
+	PathResult(Index order, Index source) : order(order), source(source) {
+		distance = new Distance[order];
+		previous = new Index[order];
+	};
+
+	~PathResult() {
+		delete[] distance;
+		delete[] previous;
+	};
+
+	PathResult(const PathResult&) = delete;
+	PathResult& operator=(const PathResult&) = delete;
+
+	bool reachable(Index v) const { return v == source || previous[v] != NO_INDEX; }
+
+	Index pathLength(Index vk) const;
+	Index extractPath(Index vk, Index* buffer) const;
+
+	Index getOrder() const { return order; }
+	Index getSource() const { return source; }
+
+	Distance* distance;
+	Index* previous;
+
+private:
+	Index order;
+	Index source;
+};
@@ -0,0 +1,275 @@
+#include "QueryServer.h"
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+QueryServer::QueryServer(Graph& graph, bool directed, size_t cacheBytes) : graph(graph), directed(directed)
+{
+	if (cacheBytes > 0) {
+		cache.reset(new ShortestPathCache(cacheBytes));
+	}
+	stopping = false;
+	query_count = 0;
+	error_count = 0;
+	total_us = 0.0;
+	max_us = 0.0;
+
+	ws.prepare(graph.getOrder(), graph.getSize() * 2);	//pierwsze zapytanie bez alokacji
+}
+
+bool QueryServer::handle(const std::string& line, std::string& response)
+{
+	timer.reset();
+	timer.start();
+
+	std::istringstream words(line);
+	std::string command, argument;
+	words >> command;
+
+	bool keepGoing = true;
+	if (command == "dijkstra") {
+		long long vp, vk;
+		if (!(words >> vp >> vk) || vp < 0 || vk < 0
+			|| vp >= (long long)graph.getOrder() || vk >= (long long)graph.getOrder()) {
+			response = "error usage: dijkstra <vp> <vk> with vertices below " + std::to_string(graph.getOrder());
+		}
+		else {
+			response = dijkstra((Index)vp, (Index)vk);
+		}
+	}
+	else if (command == "mst") {
+		words >> argument;
+		if (directed) {
+			response = "error mst needs an undirected graph (start the server with --directed 0)";
+		}
+		else if (argument == "prim" || argument == "kruskal") {
+			response = mst(argument == "prim");
+		}
+		else {
+			response = "error usage: mst prim | mst kruskal";
+		}
+	}
+	else if (command == "info") {
+		response = info();
+	}
+	else if (command == "stats") {
+		response = stats();
+	}
+	else if (command == "quit" || command == "shutdown") {
+		stopping = command == "shutdown";
+		keepGoing = false;
+		response = "ok bye";
+	}
+	else {
+		response = "error unknown query: " + command;
+	}
+
+	timer.stop();
+	double us = timer.resultNs() / 1e3;
+	query_count++;
+	if (response.compare(0, 5, "error") == 0) {
+		error_count++;
+	}
+	total_us += us;
+	max_us = std::max(max_us, us);
+
+	std::ostringstream latency;
+	latency.precision(3);
+	latency << std::fixed << " time_us " << us;
+	response += latency.str();
+	return keepGoing;
+}
+
+std::string QueryServer::dijkstra(Index vp, Index vk)
+{
+	std::string text = "ok dijkstra " + std::to_string(vp) + " " + std::to_string(vk);
+	if (cache) {
+		const PathResult* tree = cache->tree(graph, vp);
+		if (!tree->reachable(vk)) {
+			return text + " unreachable";
+		}
+		std::vector<Index> path(tree->pathLength(vk));
+		tree->extractPath(vk, path.data());
+		text += " cost " + formatNumber(tree->distance[vk]) + " path";
+		for (Index v : path) {
+			text += " " + std::to_string(v);
+		}
+		return text;
+	}
+
+	graph.spp_dijkstra_list(vp, ws);
+
+	//wynik w ws jest w numeracji wewnetrznej grafu
+	Index target = graph.toInternal(vk);
+	if (ws.distance[target] >= INFINITE_DISTANCE) {
+		return text + " unreachable";
+	}
+
+	std::vector<Index> path;
+	for (Index v = target; v != NO_INDEX; v = ws.previous[v]) {
+		path.push_back(graph.toOriginal(v));
+	}
+	text += " cost " + formatNumber(ws.distance[target]) + " path";
+	for (auto v = path.rbegin(); v != path.rend(); ++v) {
+		text += " " + std::to_string(*v);
+	}
+	return text;
+}
+
+std::string QueryServer::mst(bool prim)
+{
+	if (prim) {
+		graph.mst_prim_list(ws);
+	}
+	else {
+		graph.mst_kruskal_list(ws);
+	}
+	return std::string("ok mst ") + (prim ? "prim" : "kruskal")
+		+ " weight " + formatNumber(ws.treeWeight()) + " edges " + std::to_string(ws.tree_length);
+}
+
+std::string QueryServer::info() const
+{
+	return "ok info vertices " + std::to_string(graph.getOrder()) + " edges " + std::to_string(graph.getSize())
+		+ (directed ? " directed" : " undirected") + " weights " GRAPH_WEIGHT_NAME " indices " GRAPH_INDEX_NAME;
+}
+
+std::string QueryServer::stats() const
+{
+	std::ostringstream text;
+	text.precision(3);
+	text << std::fixed << "ok stats queries " << query_count << " errors " << error_count
+		<< " avg_us " << (query_count > 0 ? total_us / query_count : 0.0) << " max_us " << max_us;
+	if (cache) {
+		text << " cache_hits " << cache->hits << " cache_misses " << cache->misses
+			<< " cache_evictions " << cache->evictions << " cache_bytes " << cache->getUsed();
+	}
+	return text.str();
+}
+
+void QueryServer::printSummary(std::ostream& out) const
+{
+	out << "Queries: " << query_count << " (" << error_count << " errors)";
+	if (query_count > 0) {
+		out.precision(3);
+		out << std::fixed << ", average " << total_us / query_count << " us, max " << max_us << " us";
+	}
+	out << "\n";
+	if (cache) {
+		out << "Path tree cache: " << cache->hits << " hits, " << cache->misses << " misses, "
+			<< cache->evictions << " evictions\n";
+	}
+}
+
+int QueryServer::serveStream(std::istream& in, std::ostream& out)
+{
+	std::string line, response;
+	while (std::getline(in, line)) {
+		if (line.find_first_not_of(" \t\r") == std::string::npos) {
+			continue;
+		}
+		bool keepGoing = handle(line, response);
+		out << response << "\n";
+		out.flush();	//klient czeka na odpowiedz przed wyslaniem kolejnego zapytania
+		if (!keepGoing) {
+			break;
+		}
+	}
+	return 0;
+}
+
+#ifndef _WIN32
+
+namespace
+{
+	bool sendAll(int socket, const std::string& text)
+	{
+		size_t sent = 0;
+		while (sent < text.size()) {
+			ssize_t n = send(socket, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+			if (n <= 0) {
+				return false;
+			}
+			sent += (size_t)n;
+		}
+		return true;
+	}
+}
+
+int QueryServer::serveSocket(const std::string& path)
+{
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path)) {
+		std::cerr << "Error: Socket path too long: " << path << std::endl;
+		return 1;
+	}
+	std::copy(path.begin(), path.end(), address.sun_path);
+
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0) {
+		std::cerr << "Error: Failed to create socket" << std::endl;
+		return 1;
+	}
+	unlink(path.c_str());	//pozostalosc po poprzednim uruchomieniu
+	if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 8) != 0) {
+		std::cerr << "Error: Failed to listen on socket: " << path << std::endl;
+		close(listener);
+		return 1;
+	}
+	std::cerr << "Listening on " << path << std::endl;
+
+	std::vector<char> buffer(1 << 16);
+	while (!stopping) {
+		int client = accept(listener, nullptr, nullptr);
+		if (client < 0) {
+			continue;
+		}
+
+		//linie moga przychodzic w kawalkach - niepelna czeka w pending na reszte
+		std::string pending, response;
+		bool keepGoing = true;
+		while (keepGoing) {
+			ssize_t n = recv(client, buffer.data(), buffer.size(), 0);
+			if (n <= 0) {
+				break;
+			}
+			pending.append(buffer.data(), (size_t)n);
+
+			size_t begin = 0, end;
+			while (keepGoing && (end = pending.find('\n', begin)) != std::string::npos) {
+				std::string line = pending.substr(begin, end - begin);
+				begin = end + 1;
+				if (line.find_first_not_of(" \t\r") == std::string::npos) {
+					continue;
+				}
+				keepGoing = handle(line, response);
+				if (!sendAll(client, response + "\n")) {
+					keepGoing = false;
+				}
+			}
+			pending.erase(0, begin);
+		}
+		close(client);
+	}
+
+	close(listener);
+	unlink(path.c_str());
+	return 0;
+}
+
+#else
+
+int QueryServer::serveSocket(const std::string& path)
+{
+	std::cerr << "Error: Unix sockets are not supported on this platform, use stdin instead" << std::endl;
+	return 1;
+}
+
+#endif
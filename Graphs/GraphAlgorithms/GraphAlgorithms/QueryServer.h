@@ -0,0 +1,56 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include "Graph.h"
+#include "ShortestPathCache.h"
+#include "Timer.h"
+#include "Workspace.h"
+
+// Serwer zapytan: graf wczytywany jest raz, a reprezentacje i pamiec robocza zostaja
+// w pamieci pomiedzy zapytaniami. Zapytania to pojedyncze linie tekstu:
+//   dijkstra <vp> <vk>   - najkrotsza sciezka (numery oryginalne),
+//   mst prim | mst kruskal,
+//   info, stats, quit (konczy sesje), shutdown (konczy serwer).
+// Kazda odpowiedz to jedna linia "ok ..." lub "error ..." zakonczona czasem obslugi
+// zapytania w mikrosekundach (time_us), liczonym od przetworzenia linii do gotowej odpowiedzi.
+// Przy niezerowym budzecie pamieci podrecznej drzewa najkrotszych sciezek sa zachowywane,
+// wiec kolejne zapytania z tego samego zrodla odtwarzaja tylko sciezke.
+class QueryServer
+{
+public:
+	QueryServer(Graph& graph, bool directed, size_t cacheBytes = 0);
+
+	QueryServer(const QueryServer&) = delete;
+	QueryServer& operator=(const QueryServer&) = delete;
+
+	//obsluguje jedna linie; false, gdy polecenie konczy sesje (quit / shutdown)
+	bool handle(const std::string& line, std::string& response);
+
+	//zapytania ze strumienia (np. stdin/stdout) az do konca danych lub quit
+	int serveStream(std::istream& in, std::ostream& out);
+	//gniazdo Unix pod podana sciezka - klienci obslugiwani kolejno, az do shutdown
+	int serveSocket(const std::string& path);
+
+	//podsumowanie (liczba zapytan, sredni i najwiekszy czas) - na strumien diagnostyczny
+	void printSummary(std::ostream& out) const;
+
+private:
+	Graph& graph;
+	bool directed;
+	Workspace ws;
+	Timer timer;
+	std::unique_ptr<ShortestPathCache> cache;	//nullptr - bez pamieci podrecznej
+
+	bool stopping;			//otrzymano shutdown
+	long long query_count;
+	long long error_count;
+	double total_us;
+	double max_us;
+
+	std::string dijkstra(Index vp, Index vk);
+	std::string mst(bool prim);
+	std::string info() const;
+	std::string stats() const;
+};
@@ -0,0 +1,63 @@
+#include "ShortestPathCache.h"
+
+ShortestPathCache::ShortestPathCache(size_t memoryBudget)
+{
+	budget = memoryBudget;
+	used = 0;
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+size_t ShortestPathCache::treeBytes(Index order)
+{
+	return sizeof(PathResult) + (size_t)order * (sizeof(Distance) + sizeof(Index));
+}
+
+const PathResult* ShortestPathCache::tree(Graph& graph, Index vp)
+{
+	Key key = { graph.getVersion(), vp };
+	auto found = index.find(key);
+	if (found != index.end()) {
+		hits++;
+		entries.splice(entries.begin(), entries, found->second);	//na poczatek listy LRU
+		return found->second->tree.get();
+	}
+	misses++;
+
+	//Dijkstra na pamieci roboczej, wynik przepisywany do numeracji oryginalnej
+	Index order = graph.getOrder();
+	graph.spp_dijkstra_list(vp, ws);
+	PathResult* result = new PathResult(order, vp);
+	for (Index v = 0; v < order; v++) {
+		Index u = graph.toOriginal(v);
+		result->distance[u] = ws.distance[v];
+		result->previous[u] = ws.previous[v] == NO_INDEX ? NO_INDEX : graph.toOriginal(ws.previous[v]);
+	}
+
+	size_t bytes = treeBytes(order);
+	if (bytes > budget) {
+		oversized.reset(result);
+		return result;
+	}
+	while (used + bytes > budget) {
+		Entry& last = entries.back();
+		used -= treeBytes(last.tree->getOrder());
+		index.erase(last.key);
+		entries.pop_back();
+		evictions++;
+	}
+
+	entries.push_front(Entry{ key, std::unique_ptr<PathResult>(result) });
+	index[key] = entries.begin();
+	used += bytes;
+	return result;
+}
+
+void ShortestPathCache::clear()
+{
+	entries.clear();
+	index.clear();
+	oversized.reset();
+	used = 0;
+}
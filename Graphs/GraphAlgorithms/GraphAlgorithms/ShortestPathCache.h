@@ -0,0 +1,62 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include "Graph.h"
+#include "PathResult.h"
+#include "Workspace.h"
+
+// Pamiec podreczna drzew najkrotszych sciezek (tablice odleglosci i poprzednikow)
+// dla zapytan punkt-punkt o wspolnym zrodle. Kluczem jest para (zrodlo, wersja grafu),
+// wiec po przebudowie grafu stare drzewa nie sa juz trafiane i wypadaja jako najdawniej uzyte.
+// Zajetosc ograniczona jest budzetem w bajtach; drzewo wieksze niz caly budzet
+// jest liczone, ale nie trafia do pamieci.
+class ShortestPathCache
+{
+public:
+	ShortestPathCache(size_t memoryBudget);
+
+	ShortestPathCache(const ShortestPathCache&) = delete;
+	ShortestPathCache& operator=(const ShortestPathCache&) = delete;
+
+	//drzewo najkrotszych sciezek z vp (numeracja oryginalna) - z pamieci lub liczone Dijkstra;
+	//wskaznik wazny do nastepnego wywolania tree() lub clear()
+	const PathResult* tree(Graph& graph, Index vp);
+	void clear();
+
+	//rozmiar drzewa dla grafu o order wierzcholkach, wliczany do budzetu
+	static size_t treeBytes(Index order);
+
+	size_t getBudget() const { return budget; }
+	size_t getUsed() const { return used; }
+	size_t getEntries() const { return entries.size(); }
+
+	long long hits;
+	long long misses;
+	long long evictions;
+
+private:
+	struct Key {
+		unsigned long long version;
+		Index source;
+		bool operator==(const Key& other) const { return version == other.version && source == other.source; }
+	};
+	struct KeyHash {
+		size_t operator()(const Key& key) const {
+			return std::hash<unsigned long long>()(key.version * 0x9E3779B97F4A7C15ULL ^ key.source);
+		}
+	};
+	struct Entry {
+		Key key;
+		std::unique_ptr<PathResult> tree;
+	};
+
+	size_t budget;
+	size_t used;
+
+	std::list<Entry> entries;	//od ostatnio uzytego do najdawniej uzytego
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+	std::unique_ptr<PathResult> oversized;	//ostatnie drzewo, ktore nie zmiescilo sie w budzecie
+	Workspace ws;
+};
@@ -0,0 +1,246 @@
+#include "VertexOrdering.h"
+#include <algorithm>
+
+namespace
+{
+	// Nieskierowana lista sasiedztwa w postaci zwartej, tylko na czas wyznaczania kolejnosci
+	struct Neighbourhood
+	{
+		Neighbourhood(Edge* const* edges, Index size, Index order) {
+			offset = new Index[order + 1];
+			target = new Index[size > 0 ? (size_t)size * 2 : 1];
+			for (Index v = 0; v <= order; v++) {
+				offset[v] = 0;
+			}
+			for (Index i = 0; i < size; i++) {
+				offset[edges[i]->v1 + 1]++;
+				offset[edges[i]->v2 + 1]++;
+			}
+			for (Index v = 0; v < order; v++) {
+				offset[v + 1] += offset[v];
+			}
+
+			Index* next = new Index[order];
+			for (Index v = 0; v < order; v++) {
+				next[v] = offset[v];
+			}
+			for (Index i = 0; i < size; i++) {
+				target[next[edges[i]->v1]++] = edges[i]->v2;
+				target[next[edges[i]->v2]++] = edges[i]->v1;
+			}
+			delete[] next;
+		};
+
+		~Neighbourhood() {
+			delete[] offset;
+			delete[] target;
+		};
+
+		Index degree(Index v) const { return offset[v + 1] - offset[v]; }
+
+		Index* offset;
+		Index* target;
+	};
+
+	// BFS z wierzcholka start po wierzcholkach z level == NO_INDEX. Kolejnosc odwiedzin
+	// trafia do queue, zwracana jest liczba odwiedzonych. level zostaje wypelnione.
+	Index levelSearch(const Neighbourhood& graph, Index start, Index* level, Index* queue)
+	{
+		Index head = 0, tail = 0;
+		level[start] = 0;
+		queue[tail++] = start;
+		while (head < tail) {
+			Index u = queue[head++];
+			for (Index i = graph.offset[u]; i < graph.offset[u + 1]; i++) {
+				Index v = graph.target[i];
+				if (level[v] == NO_INDEX) {
+					level[v] = level[u] + 1;
+					queue[tail++] = v;
+				}
+			}
+		}
+		return tail;
+	}
+
+	// Wierzcholek pseudo-peryferyjny (George, Liu): z najglebszego poziomu BFS wybierany jest
+	// wierzcholek o najmniejszym stopniu, dopoki glebokosc drzewa BFS rosnie
+	Index peripheralVertex(const Neighbourhood& graph, Index start, Index* level, Index* queue)
+	{
+		Index depth = 0;
+		for (int attempt = 0; attempt < 8; attempt++) {
+			Index reached = levelSearch(graph, start, level, queue);
+			Index last = level[queue[reached - 1]];
+
+			Index candidate = queue[reached - 1];
+			for (Index i = reached; i > 0 && level[queue[i - 1]] == last; i--) {
+				if (graph.degree(queue[i - 1]) < graph.degree(candidate)) {
+					candidate = queue[i - 1];
+				}
+			}
+			for (Index i = 0; i < reached; i++) {	//czyszczone sa tylko odwiedzone
+				level[queue[i]] = NO_INDEX;
+			}
+
+			if (attempt > 0 && last <= depth) {
+				break;
+			}
+			depth = last;
+			start = candidate;
+		}
+		return start;
+	}
+}
+
+void VertexOrdering::allocate(Index graph_order)
+{
+	reset();
+	order = graph_order;
+	new_id = new Index[order];
+	original_id = new Index[order];
+}
+
+void VertexOrdering::reset()
+{
+	delete[] new_id;
+	delete[] original_id;
+	new_id = nullptr;
+	original_id = nullptr;
+	order = 0;
+}
+
+void VertexOrdering::compute(Edge* const* edges, Index size, Index graph_order, Kind kind)
+{
+	if (kind == Kind::Original) {
+		reset();
+		return;
+	}
+	allocate(graph_order);
+	Neighbourhood graph(edges, size, order);
+
+	//sequence (= original_id) - wierzcholki w nowej kolejnosci
+	Index* sequence = original_id;
+	Index* level = new_id;	//new_id jako tablica robocza, wypelniane na koncu
+	for (Index v = 0; v < order; v++) {
+		sequence[v] = v;
+		level[v] = NO_INDEX;
+	}
+
+	if (kind == Kind::Degree) {
+		std::stable_sort(sequence, sequence + order, [&graph](Index a, Index b) {
+			return graph.degree(a) > graph.degree(b);
+		});
+	}
+	else if (kind == Kind::BFS) {
+		Index placed = 0;
+		for (Index s = 0; s < order; s++) {
+			if (level[s] == NO_INDEX) {
+				placed += levelSearch(graph, s, level, sequence + placed);
+			}
+		}
+	}
+	else {
+		//kolejne skladowe zaczynane od wierzcholkow o najmniejszym stopniu
+		Index* byDegree = new Index[order];
+		Index* scratch = new Index[order];
+		for (Index v = 0; v < order; v++) {
+			byDegree[v] = v;
+		}
+		std::stable_sort(byDegree, byDegree + order, [&graph](Index a, Index b) {
+			return graph.degree(a) < graph.degree(b);
+		});
+
+		bool* placedVertex = new bool[order];
+		for (Index v = 0; v < order; v++) {
+			placedVertex[v] = false;
+		}
+
+		Index placed = 0;
+		for (Index k = 0; k < order; k++) {
+			if (placedVertex[byDegree[k]]) {
+				continue;
+			}
+			Index start = peripheralVertex(graph, byDegree[k], level, scratch);
+
+			//Cuthill-McKee: nieodwiedzeni sasiedzi dopisywani wedlug rosnacego stopnia
+			Index head = placed;
+			sequence[placed++] = start;
+			placedVertex[start] = true;
+			while (head < placed) {
+				Index u = sequence[head++];
+				Index first = placed;
+				for (Index i = graph.offset[u]; i < graph.offset[u + 1]; i++) {
+					Index v = graph.target[i];
+					if (!placedVertex[v]) {
+						placedVertex[v] = true;
+						sequence[placed++] = v;
+					}
+				}
+				std::sort(sequence + first, sequence + placed, [&graph](Index a, Index b) {
+					return graph.degree(a) < graph.degree(b) || (graph.degree(a) == graph.degree(b) && a < b);
+				});
+			}
+		}
+		std::reverse(sequence, sequence + order);
+
+		delete[] placedVertex;
+		delete[] scratch;
+		delete[] byDegree;
+	}
+
+	for (Index k = 0; k < order; k++) {
+		new_id[sequence[k]] = k;
+	}
+}
+
+void VertexOrdering::append(const VertexOrdering& next)
+{
+	if (next.isIdentity()) {
+		return;
+	}
+	if (isIdentity()) {
+		allocate(next.order);
+		for (Index v = 0; v < order; v++) {
+			new_id[v] = next.new_id[v];
+			original_id[v] = next.original_id[v];
+		}
+		return;
+	}
+	for (Index v = 0; v < order; v++) {
+		new_id[v] = next.new_id[new_id[v]];
+	}
+	for (Index v = 0; v < order; v++) {
+		original_id[new_id[v]] = v;
+	}
+}
+
+const char* VertexOrdering::name(Kind kind)
+{
+	switch (kind) {
+	case Kind::BFS: return "BFS";
+	case Kind::RCM: return "RCM";
+	case Kind::Degree: return "Degree";
+	default: return "Original";
+	}
+}
+
+Index VertexOrdering::bandwidth(Edge* const* edges, Index size)
+{
+	Index result = 0;
+	for (Index i = 0; i < size; i++) {
+		Index span = edges[i]->v1 > edges[i]->v2 ? edges[i]->v1 - edges[i]->v2 : edges[i]->v2 - edges[i]->v1;
+		result = std::max(result, span);
+	}
+	return result;
+}
+
+double VertexOrdering::averageSpan(Edge* const* edges, Index size)
+{
+	if (size == 0) {
+		return 0.0;
+	}
+	double sum = 0.0;
+	for (Index i = 0; i < size; i++) {
+		sum += edges[i]->v1 > edges[i]->v2 ? edges[i]->v1 - edges[i]->v2 : edges[i]->v2 - edges[i]->v1;
+	}
+	return sum / size;
+}
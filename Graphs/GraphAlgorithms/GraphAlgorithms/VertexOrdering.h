@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Edge.h"
+
+// Przenumerowanie wierzcholkow poprawiajace lokalnosc dostepow: sasiedzi dostaja
+// bliskie numery, wiec Prim i Dijkstra czytaja tablice kluczy, odleglosci i odwiedzin
+// z niewielu linii pamieci podrecznej. Do wyznaczenia kolejnosci krawedzie
+// traktowane sa jak nieskierowane.
+//   BFS    - kolejnosc przeszukiwania wszerz, skladowa po skladowej,
+//   RCM    - odwrocony Cuthill-McKee: BFS z wierzcholka pseudo-peryferyjnego,
+//            sasiedzi w kolejnosci rosnacego stopnia, na koniec odwrocenie (waskie pasmo),
+//   Degree - wierzcholki wedlug malejacego stopnia (najczesciej odwiedzane na poczatku).
+// Permutacja przechowywana jest w obie strony; pusta (nullptr) oznacza tozsamosc.
+class VertexOrdering
+{
+public:
+	enum class Kind { Original, BFS, RCM, Degree };
+
+	VertexOrdering() {
+		order = 0;
+		new_id = nullptr;
+		original_id = nullptr;
+	};
+
+	~VertexOrdering() {
+		reset();
+	};
+
+	VertexOrdering(const VertexOrdering&) = delete;
+	VertexOrdering& operator=(const VertexOrdering&) = delete;
+
+	//wyznacza permutacje dla grafu o order wierzcholkach i size krawedziach
+	void compute(Edge* const* edges, Index size, Index order, Kind kind);
+	//skladanie: po wywolaniu this opisuje najpierw siebie, a potem permutacje next
+	void append(const VertexOrdering& next);
+	void reset();
+
+	bool isIdentity() const { return new_id == nullptr; }
+	Index toNew(Index v) const { return new_id ? new_id[v] : v; }
+	Index toOriginal(Index v) const { return original_id ? original_id[v] : v; }
+
+	static const char* name(Kind kind);
+
+	//najwieksza i srednia roznica numerow koncow krawedzi - miary lokalnosci numeracji
+	static Index bandwidth(Edge* const* edges, Index size);
+	static double averageSpan(Edge* const* edges, Index size);
+
+	Index* new_id;		//new_id[stary numer] = nowy numer
+	Index* original_id;	//original_id[nowy numer] = stary numer
+
+private:
+	Index order;
+
+	void allocate(Index order);
+};
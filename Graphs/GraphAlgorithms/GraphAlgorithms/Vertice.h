@@ -1,8 +0,0 @@
-#pragma once
-struct Vertice
-{
-	int id;
-	int distance;
-	Vertice* previous;
-};
-
@@ -0,0 +1,56 @@
+#include "Workspace.h"
+
+void Workspace::prepare(Index order, Index arcs)
+{
+	Index words = (order + 63) / 64;
+
+	if (order > capacity) {
+		delete[] visited;
+		delete[] distance;
+		delete[] previous;
+		delete[] tree;
+
+		capacity = order;
+		visited = new unsigned long long[(capacity + 63) / 64];
+		distance = new Distance[capacity];
+		previous = new Index[capacity];
+		tree = new Edge[capacity];
+	}
+
+	for (Index i = 0; i < words; i++) {
+		visited[i] = 0;
+	}
+	tree_length = 0;
+
+	edge_heap.reserve(arcs);
+	edge_heap.clear();
+	vertex_heap.reserve(order);
+	sets.reset(order);
+}
+
+void Workspace::addTreeEdge(Index v1, Index v2, Weight weight)
+{
+	tree[tree_length].v1 = v1;
+	tree[tree_length].v2 = v2;
+	tree[tree_length].weight = weight;
+	tree_length++;
+}
+
+Distance Workspace::treeWeight() const
+{
+	Distance weight = 0;
+	for (Index i = 0; i < tree_length; i++) {
+		weight += tree[i].weight;
+	}
+	return weight;
+}
+
+//kopia drzewa w postaci listy - dla wywolan, ktore wypisuja wynik
+List* Workspace::treeToList() const
+{
+	List* result = new List();
+	for (Index i = 0; i < tree_length; i++) {
+		result->push(new Edge(tree[i]));
+	}
+	return result;
+}
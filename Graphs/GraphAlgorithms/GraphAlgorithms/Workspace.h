@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Edge.h"
+#include "EdgeHeap.h"
+#include "IndexedHeap.h"
+#include "DisjointSets.h"
+#include "List.h"
+
+// Pamiec robocza algorytmow MST i najkrotszych sciezek. Jeden obiekt na watek
+// moze byc przekazywany do kolejnych wywolan - prepare() alokuje tylko wtedy,
+// gdy graf jest wiekszy niz poprzednio, wiec powtarzane uruchomienia na grafach
+// tej samej wielkosci nie wykonuja zadnej alokacji.
+class Workspace
+{
+public:
+	Workspace() {
+		capacity = 0;
+		visited = nullptr;
+		distance = nullptr;
+		previous = nullptr;
+		tree = nullptr;
+		tree_length = 0;
+	};
+
+	~Workspace() {
+		delete[] visited;
+		delete[] distance;
+		delete[] previous;
+		delete[] tree;
+	};
+
+	Workspace(const Workspace&) = delete;
+	Workspace& operator=(const Workspace&) = delete;
+
+	void prepare(Index order, Index arcs);
+
+	bool isVisited(Index v) const { return (visited[v >> 6] >> (v & 63)) & 1; }
+	void markVisited(Index v) { visited[v >> 6] |= 1ULL << (v & 63); }
+
+	void addTreeEdge(Index v1, Index v2, Weight weight);
+	Distance treeWeight() const;
+	List* treeToList() const;
+
+	EdgeHeap edge_heap;
+	IndexedHeap vertex_heap;
+	DisjointSets sets;
+
+	Distance* distance;	//w algorytmie Prima - klucze wierzcholkow
+	Index* previous;
+
+	Edge* tree;			//krawedzie drzewa (lasu) rozpinajacego
+	Index tree_length;
+
+private:
+	unsigned long long* visited;	//mapa bitowa odwiedzonych wierzcholkow
+	Index capacity;
+};
@@ -0,0 +1,490 @@
+#include "AutoTest.h"
+#include <algorithm>
+#include <memory>
+#include <iomanip>
+#include <thread>
+#include "Timer.h"
+
+template <typename T>
+AutoTest<T>::AutoTest(int size, int trials, unsigned seed)
+	: size(size), trials(trials), arrays(1), k(std::max(1, size / 100)), generator(seed),
+	cases(allCases()), parallelCases(allParallelCases()), selectionCases(allSelectionCases())
+{
+	distributions = {
+		Distribution::Random,
+		Distribution::Ascending,
+		Distribution::Descending,
+		Distribution::Presorted33,
+		Distribution::Presorted66,
+		Distribution::FewUnique,
+		Distribution::Runs
+	};
+
+	// Powers of two up to the hardware concurrency, and the concurrency itself
+	int hardware = std::max(1, (int)std::thread::hardware_concurrency());
+	for (int threads = 1; threads < hardware; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(hardware);
+}
+
+template <typename T>
+std::vector<typename AutoTest<T>::Case> AutoTest<T>::allCases()
+{
+	return {
+		{ "insertion", [](Sorter<T>& s, T* a, int n) { s.insertionSort(a, n); } },
+		{ "heap", [](Sorter<T>& s, T* a, int n) { s.heapSort(a, n); } },
+		{ "shell_shell", [](Sorter<T>& s, T* a, int n) { s.shellSort(a, n, GapSequence::Shell); } },
+		{ "shell_knuth", [](Sorter<T>& s, T* a, int n) { s.shellSort(a, n, GapSequence::Knuth); } },
+		{ "shell_sedgewick", [](Sorter<T>& s, T* a, int n) { s.shellSort(a, n, GapSequence::Sedgewick); } },
+		{ "shell_ciura", [](Sorter<T>& s, T* a, int n) { s.shellSort(a, n, GapSequence::Ciura); } },
+		{ "quick_left", [](Sorter<T>& s, T* a, int n) { s.quickSort(a, n, PivotStrategy::Left); } },
+		{ "quick_right", [](Sorter<T>& s, T* a, int n) { s.quickSort(a, n, PivotStrategy::Right); } },
+		{ "quick_middle", [](Sorter<T>& s, T* a, int n) { s.quickSort(a, n, PivotStrategy::Middle); } },
+		{ "quick_random", [](Sorter<T>& s, T* a, int n) { s.quickSort(a, n, PivotStrategy::Random); } },
+		{ "quick_median3", [](Sorter<T>& s, T* a, int n) { s.quickSort(a, n, PivotStrategy::MedianOfThree); } },
+		{ "quick_median3_scalar", [](Sorter<T>& s, T* a, int n) {
+			bool simd = s.simdEnabled();
+			s.setSimd(false);
+			s.quickSort(a, n, PivotStrategy::MedianOfThree);
+			s.setSimd(simd);
+		} },
+		{ "small_sort", [](Sorter<T>& s, T* a, int n) { s.smallSort(a, n); } },
+		{ "hybrid", [](Sorter<T>& s, T* a, int n) { s.hybridSort(a, n); } },
+		{ "radix8", [](Sorter<T>& s, T* a, int n) { s.radixSort(a, n, 8); } },
+		{ "radix11", [](Sorter<T>& s, T* a, int n) { s.radixSort(a, n, 11); } },
+		{ "counting", [](Sorter<T>& s, T* a, int n) { s.countingSort(a, n); } }
+	};
+}
+
+template <typename T>
+std::vector<typename AutoTest<T>::ParallelCase> AutoTest<T>::allParallelCases()
+{
+	return {
+		{ "parallel_quick", [](ParallelSorter<T>& s, T* a, int n) { s.quickSort(a, n); } },
+		{ "parallel_merge", [](ParallelSorter<T>& s, T* a, int n) { s.mergeSort(a, n); } }
+	};
+}
+
+template <typename T>
+std::vector<typename AutoTest<T>::SelectionCase> AutoTest<T>::allSelectionCases()
+{
+	return {
+		{ "nth_element", false, [](Sorter<T>& s, T* a, int n, int k) { s.nthElement(a, n, k - 1); } },
+		{ "partial_sort", true, [](Sorter<T>& s, T* a, int n, int k) { s.partialSort(a, n, k); } },
+		{ "top_k", true, [](Sorter<T>& s, T* a, int n, int k) {
+			// The heap leaves the array alone, the result is copied over its front for verification
+			std::vector<T> output(k);
+			int count = s.topK(a, n, k, output.data());
+			std::copy(output.begin(), output.begin() + count, a);
+		} }
+	};
+}
+
+namespace
+{
+	// Verifies a selection of the k smallest elements against a sorted copy of the input
+	template <typename T>
+	bool isSelected(const T* result, const T* reference, int size, int k, bool ordered)
+	{
+		auto equivalent = [](const T& a, const T& b) { return !(a < b) && !(b < a); };
+		if (ordered)
+		{
+			for (int i = 0; i < k; i++)
+			{
+				if (!equivalent(result[i], reference[i]))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		const T& pivot = result[k - 1];
+		if (!equivalent(pivot, reference[k - 1]))
+		{
+			return false;
+		}
+		for (int i = 0; i < size; i++)
+		{
+			if (i < k - 1 ? pivot < result[i] : result[i] < pivot)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+// Keeps only the algorithms whose name contains filter (comma separated alternatives)
+template <typename T>
+void AutoTest<T>::selectAlgorithms(const std::string& filter)
+{
+	std::vector<std::string> parts;
+	size_t start = 0;
+	while (start <= filter.size())
+	{
+		size_t end = filter.find(',', start);
+		if (end == std::string::npos)
+		{
+			end = filter.size();
+		}
+		if (end > start)
+		{
+			parts.push_back(filter.substr(start, end - start));
+		}
+		start = end + 1;
+	}
+
+	auto matches = [&parts](const std::string& name) {
+		for (const std::string& part : parts)
+		{
+			if (name.find(part) != std::string::npos)
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	std::vector<Case> selected;
+	for (const Case& c : cases)
+	{
+		if (matches(c.name))
+		{
+			selected.push_back(c);
+		}
+	}
+	cases = selected;
+
+	std::vector<ParallelCase> selectedParallel;
+	for (const ParallelCase& c : parallelCases)
+	{
+		if (matches(c.name))
+		{
+			selectedParallel.push_back(c);
+		}
+	}
+	parallelCases = selectedParallel;
+
+	std::vector<SelectionCase> selectedSelection;
+	for (const SelectionCase& c : selectionCases)
+	{
+		if (matches(c.name))
+		{
+			selectedSelection.push_back(c);
+		}
+	}
+	selectionCases = selectedSelection;
+}
+
+template <typename T>
+void AutoTest<T>::selectDistribution(Distribution distribution)
+{
+	distributions = { distribution };
+}
+
+template <typename T>
+void AutoTest<T>::selectThreads(const std::vector<int>& threads)
+{
+	threadCounts = { 1 };
+	for (int count : threads)
+	{
+		if (count > 1 && std::find(threadCounts.begin(), threadCounts.end(), count) == threadCounts.end())
+		{
+			threadCounts.push_back(count);
+		}
+	}
+}
+
+template <typename T>
+void AutoTest<T>::selectArrays(int count)
+{
+	arrays = count;
+}
+
+template <typename T>
+void AutoTest<T>::selectK(int count)
+{
+	k = std::min(std::max(count, 1), size);
+}
+
+template <typename T>
+const char* AutoTest<T>::distributionName(Distribution distribution)
+{
+	switch (distribution)
+	{
+	case Distribution::Random: return "random";
+	case Distribution::Ascending: return "ascending";
+	case Distribution::Descending: return "descending";
+	case Distribution::Presorted33: return "presorted33";
+	case Distribution::Presorted66: return "presorted66";
+	case Distribution::FewUnique: return "few_unique";
+	case Distribution::Runs: return "runs";
+	}
+	return "unknown";
+}
+
+template <typename T>
+void AutoTest<T>::generate(T* array, int size, Distribution distribution, std::mt19937& generator)
+{
+	switch (distribution)
+	{
+	case Distribution::Random:
+		for (int i = 0; i < size; i++)
+		{
+			array[i] = ElementTraits<T>::random(generator);
+		}
+		break;
+	case Distribution::Ascending:
+	case Distribution::Descending:
+		for (int i = 0; i < size; i++)
+		{
+			array[i] = ElementTraits<T>::random(generator);
+		}
+		std::sort(array, array + size);
+		if (distribution == Distribution::Descending)
+		{
+			std::reverse(array, array + size);
+		}
+		break;
+	case Distribution::Presorted33:
+	case Distribution::Presorted66:
+	{
+		for (int i = 0; i < size; i++)
+		{
+			array[i] = ElementTraits<T>::random(generator);
+		}
+		int percent = distribution == Distribution::Presorted33 ? 33 : 66;
+		int sortedPart = (int)((long long)size * percent / 100);
+		std::sort(array, array + sortedPart);
+		break;
+	}
+	case Distribution::FewUnique:
+	{
+		std::uniform_int_distribution<int> keys(0, 9);
+		for (int i = 0; i < size; i++)
+		{
+			array[i] = ElementTraits<T>::fromKey(keys(generator) * 1000);
+		}
+		break;
+	}
+	case Distribution::Runs:
+	{
+		const int runs = 16;
+		for (int i = 0; i < size; i++)
+		{
+			array[i] = ElementTraits<T>::random(generator);
+		}
+		for (int r = 0; r < runs; r++)
+		{
+			T* begin = array + (long long)size * r / runs;
+			T* end = array + (long long)size * (r + 1) / runs;
+			std::sort(begin, end);
+			if (r % 2 == 1)
+			{
+				std::reverse(begin, end);
+			}
+		}
+		break;
+	}
+	}
+}
+
+template <typename T>
+int AutoTest<T>::run(std::ostream& csv)
+{
+	// One measured row per sequential algorithm, per selection algorithm (after
+	// the full_sort baseline) and per parallel algorithm and thread count
+	struct Row
+	{
+		std::string name;
+		int threads;
+		std::function<void(T*, int)> sort;
+		bool selection;
+		bool ordered;
+	};
+
+	const char* type = ElementTraits<T>::name();
+	Sorter<T> sorter;
+	std::vector<std::unique_ptr<ParallelSorter<T>>> parallelSorters;
+	std::vector<Row> rows;
+	for (const Case& c : cases)
+	{
+		auto sort = c.sort;
+		rows.push_back({ c.name, 1, [&sorter, sort](T* a, int n) { sort(sorter, a, n); }, false, false });
+	}
+	size_t firstSelection = rows.size();
+	if (!selectionCases.empty())
+	{
+		rows.push_back({ "full_sort", 1, [&sorter](T* a, int n) { sorter.hybridSort(a, n); }, true, true });
+		for (const SelectionCase& c : selectionCases)
+		{
+			auto select = c.select;
+			int count = k;
+			rows.push_back({ c.name, 1, [&sorter, select, count](T* a, int n) { select(sorter, a, n, count); }, true, c.ordered });
+		}
+	}
+	size_t firstParallel = rows.size();
+	if (!parallelCases.empty())
+	{
+		for (int threads : threadCounts)
+		{
+			parallelSorters.emplace_back(new ParallelSorter<T>(threads));
+			ParallelSorter<T>* parallel = parallelSorters.back().get();
+			for (const ParallelCase& c : parallelCases)
+			{
+				auto sort = c.sort;
+				rows.push_back({ c.name, threads, [parallel, sort](T* a, int n) { sort(*parallel, a, n); }, false, false });
+			}
+		}
+	}
+
+	std::vector<T> source((size_t)size * arrays);
+	std::vector<T> work((size_t)size * arrays);
+	std::vector<T> reference;	// sorted copy of source, checks the selections
+	std::vector<std::vector<double>> totalMs(rows.size(), std::vector<double>(distributions.size(), 0.0));
+	Timer timer;
+	int failures = 0;
+
+	csv << "algorithm,type,distribution,size,arrays,threads,trial,time_ns,sorted\n";
+
+	for (int trial = 0; trial < trials; trial++)
+	{
+		for (size_t d = 0; d < distributions.size(); d++)
+		{
+			for (int a = 0; a < arrays; a++)
+			{
+				generate(source.data() + (size_t)a * size, size, distributions[d], generator);
+			}
+			if (!selectionCases.empty())
+			{
+				reference = source;
+				for (int a = 0; a < arrays; a++)
+				{
+					std::sort(reference.begin() + (size_t)a * size, reference.begin() + (size_t)(a + 1) * size);
+				}
+			}
+
+			for (size_t r = 0; r < rows.size(); r++)
+			{
+				std::copy(source.begin(), source.end(), work.begin());
+
+				timer.reset();
+				timer.start();
+				for (int a = 0; a < arrays; a++)
+				{
+					rows[r].sort(work.data() + (size_t)a * size, size);
+				}
+				timer.stop();
+
+				long long ns = timer.resultNs();
+				bool sorted = true;
+				for (int a = 0; a < arrays && sorted; a++)
+				{
+					const T* result = work.data() + (size_t)a * size;
+					sorted = rows[r].selection
+						? isSelected(result, reference.data() + (size_t)a * size, size, k, rows[r].ordered)
+						: Sorter<T>::isSorted(result, size);
+				}
+				if (!sorted)
+				{
+					failures++;
+					std::cerr << "Error: " << rows[r].name << " (" << rows[r].threads << " threads) "
+						<< (rows[r].selection ? "selected wrong elements of a " : "left a ")
+						<< distributionName(distributions[d]) << (rows[r].selection ? " array" : " array unsorted")
+						<< " (trial " << trial << ")\n";
+				}
+				totalMs[r][d] += ns / 1e6;
+
+				csv << rows[r].name << "," << type << "," << distributionName(distributions[d]) << "," << size << "," << arrays << ","
+					<< rows[r].threads << "," << trial << "," << ns << "," << (sorted ? 1 : 0) << "\n";
+			}
+		}
+		std::cout << "Completed trial " << (trial + 1) << "/" << trials << "\n";
+	}
+
+	// Average per algorithm and distribution, in milliseconds
+	std::cout << "\n=== AVERAGE TIME [ms], " << type << ", size " << size;
+	if (arrays > 1)
+	{
+		std::cout << " x " << arrays << " arrays";
+	}
+	std::cout << ", " << trials << " trials ===\n";
+	std::cout << std::left << std::setw(22) << "algorithm";
+	for (Distribution distribution : distributions)
+	{
+		std::cout << std::right << std::setw(13) << distributionName(distribution);
+	}
+	std::cout << "\n";
+	for (size_t r = 0; r < rows.size(); r++)
+	{
+		std::string label = rows[r].name;
+		if (r >= firstParallel)
+		{
+			label += " x" + std::to_string(rows[r].threads);
+		}
+		std::cout << std::left << std::setw(22) << label;
+		for (size_t d = 0; d < distributions.size(); d++)
+		{
+			std::cout << std::right << std::setw(13) << std::fixed << std::setprecision(4) << totalMs[r][d] / trials;
+		}
+		std::cout << "\n";
+	}
+
+	// Selections against sorting the whole array, over all distributions together
+	if (!selectionCases.empty())
+	{
+		std::cout << "\n=== SELECTION, k = " << k << " (all distributions) ===\n";
+		std::cout << std::left << std::setw(22) << "algorithm" << std::right << std::setw(13) << "time [ms]"
+			<< std::setw(14) << "vs full sort" << "\n";
+		double baseTime = 0.0;
+		for (size_t d = 0; d < distributions.size(); d++)
+		{
+			baseTime += totalMs[firstSelection][d] / trials;
+		}
+		for (size_t r = firstSelection; r < firstParallel; r++)
+		{
+			double time = 0.0;
+			for (size_t d = 0; d < distributions.size(); d++)
+			{
+				time += totalMs[r][d] / trials;
+			}
+			std::cout << std::left << std::setw(22) << rows[r].name << std::right << std::setw(13) << std::setprecision(4) << time
+				<< std::setw(13) << std::setprecision(2) << (time > 0.0 ? baseTime / time : 0.0) << "x\n";
+		}
+	}
+
+	// Scaling of the parallel algorithms over all distributions together;
+	// the baseline is the same algorithm on one thread (always the first thread count)
+	if (!parallelCases.empty())
+	{
+		std::cout << "\n=== PARALLEL SCALING (all distributions) ===\n";
+		std::cout << std::left << std::setw(22) << "algorithm" << std::right << std::setw(9) << "threads"
+			<< std::setw(13) << "time [ms]" << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << "\n";
+		for (size_t r = firstParallel; r < rows.size(); r++)
+		{
+			size_t baseline = firstParallel + (r - firstParallel) % parallelCases.size();
+			double time = 0.0;
+			double baseTime = 0.0;
+			for (size_t d = 0; d < distributions.size(); d++)
+			{
+				time += totalMs[r][d] / trials;
+				baseTime += totalMs[baseline][d] / trials;
+			}
+			double speedup = time > 0.0 ? baseTime / time : 0.0;
+			std::cout << std::left << std::setw(22) << rows[r].name << std::right << std::setw(9) << rows[r].threads
+				<< std::setw(13) << std::setprecision(4) << time << std::setw(10) << std::setprecision(2) << speedup
+				<< std::setw(12) << speedup / rows[r].threads << "\n";
+		}
+	}
+
+	return failures;
+}
+
+template class AutoTest<int>;
+template class AutoTest<long long>;
+template class AutoTest<float>;
+template class AutoTest<double>;
+template class AutoTest<Record>;
@@ -0,0 +1,89 @@
+#pragma once
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "ElementTypes.h"
+#include "ParallelSorter.h"
+#include "Sorter.h"
+
+// Shape of the generated input arrays
+enum class Distribution
+{
+	Random,
+	Ascending,
+	Descending,
+	Presorted33,	// first 33% already sorted, rest random
+	Presorted66,	// first 66% already sorted, rest random
+	FewUnique,		// random values from a small set of distinct keys
+	Runs			// 16 sorted runs, every other one descending
+};
+
+// Automated benchmark: for every trial a fresh array of each requested
+// distribution is generated, and every algorithm sorts its own copy of it.
+// Each run is verified and its time (Timer, nanoseconds) written as a CSV row.
+// Parallel algorithms are run once for every selected thread count and
+// additionally summarized as speedup and efficiency against one thread.
+// Selection algorithms (k smallest elements) are compared with a full sort
+// of the same arrays, which is measured as the full_sort row.
+// Instantiated for every ElementType; values come from ElementTraits<T>.
+template <typename T>
+class AutoTest
+{
+public:
+	struct Case
+	{
+		std::string name;
+		std::function<void(Sorter<T>&, T*, int)> sort;
+	};
+
+	struct ParallelCase
+	{
+		std::string name;
+		std::function<void(ParallelSorter<T>&, T*, int)> sort;
+	};
+
+	// Selection of the k smallest elements. Ordered cases have to leave them
+	// sorted at the front of the array, the others only the element of rank
+	// k - 1 at index k - 1 with nothing greater before it and nothing smaller after it.
+	struct SelectionCase
+	{
+		std::string name;
+		bool ordered;
+		std::function<void(Sorter<T>&, T*, int, int)> select;
+	};
+
+	AutoTest(int size, int trials, unsigned seed);
+
+	void selectAlgorithms(const std::string& filter);
+	void selectDistribution(Distribution distribution);
+	// Thread counts of the parallel algorithms, 1 is always added as the baseline
+	void selectThreads(const std::vector<int>& threads);
+	// Every measured run sorts this many independent arrays of the given size
+	// one after another, which makes small arrays measurable
+	void selectArrays(int count);
+	// Number of elements the selection algorithms look for (default: 1% of the size)
+	void selectK(int count);
+
+	// Returns the number of runs that produced an unsorted array
+	int run(std::ostream& csv);
+
+	static void generate(T* array, int size, Distribution distribution, std::mt19937& generator);
+	static const char* distributionName(Distribution distribution);
+	static std::vector<Case> allCases();
+	static std::vector<ParallelCase> allParallelCases();
+	static std::vector<SelectionCase> allSelectionCases();
+
+private:
+	int size;
+	int trials;
+	int arrays;
+	int k;
+	std::mt19937 generator;
+	std::vector<Case> cases;
+	std::vector<ParallelCase> parallelCases;
+	std::vector<SelectionCase> selectionCases;
+	std::vector<int> threadCounts;
+	std::vector<Distribution> distributions;
+};
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+// Small fixed-size record sorted by its key; value travels with the key
+struct Record
+{
+	long long key;
+	long long value;
+
+	bool operator<(const Record& other) const { return key < other.key; }
+};
+
+// Text form of a record: "key value"
+inline std::istream& operator>>(std::istream& in, Record& record)
+{
+	return in >> record.key >> record.value;
+}
+
+inline std::ostream& operator<<(std::ostream& out, const Record& record)
+{
+	return out << record.key << " " << record.value;
+}
+
+// Element types selectable at runtime
+enum class ElementType
+{
+	Int,
+	Float,
+	Double,
+	Int64,
+	Record
+};
+
+// Parses "int", "float", "double", "int64" or "record"; returns false for anything else
+inline bool parseElementType(const std::string& text, ElementType& type)
+{
+	if (text == "int") { type = ElementType::Int; return true; }
+	if (text == "float") { type = ElementType::Float; return true; }
+	if (text == "double") { type = ElementType::Double; return true; }
+	if (text == "int64") { type = ElementType::Int64; return true; }
+	if (text == "record") { type = ElementType::Record; return true; }
+	return false;
+}
+
+// Per-type properties chosen at compile time.
+// Key is an unsigned integer whose natural order matches the order of the
+// elements, which is what radix-style sorts operate on.
+template <typename T>
+struct ElementTraits;
+
+template <>
+struct ElementTraits<int>
+{
+	typedef uint32_t Key;
+	static const char* name() { return "int"; }
+	static Key key(int value) { return (Key)value ^ 0x80000000u; }	// flip the sign bit
+	static int random(std::mt19937& generator) { return (int)generator(); }
+	static int fromKey(int k) { return k; }
+};
+
+template <>
+struct ElementTraits<long long>
+{
+	typedef uint64_t Key;
+	static const char* name() { return "int64"; }
+	static Key key(long long value) { return (Key)value ^ 0x8000000000000000ull; }
+	static long long random(std::mt19937& generator)
+	{
+		return (long long)(((uint64_t)generator() << 32) | generator());
+	}
+	static long long fromKey(int k) { return k; }
+};
+
+template <>
+struct ElementTraits<float>
+{
+	typedef uint32_t Key;
+	static const char* name() { return "float"; }
+	// Negative floats have their bits inverted, positive ones only the sign bit set
+	static Key key(float value)
+	{
+		Key bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+	}
+	static float random(std::mt19937& generator)
+	{
+		return std::uniform_real_distribution<float>(-1e6f, 1e6f)(generator);
+	}
+	static float fromKey(int k) { return (float)k; }
+};
+
+template <>
+struct ElementTraits<double>
+{
+	typedef uint64_t Key;
+	static const char* name() { return "double"; }
+	static Key key(double value)
+	{
+		Key bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return (bits & 0x8000000000000000ull) ? ~bits : bits | 0x8000000000000000ull;
+	}
+	static double random(std::mt19937& generator)
+	{
+		return std::uniform_real_distribution<double>(-1e9, 1e9)(generator);
+	}
+	static double fromKey(int k) { return (double)k; }
+};
+
+template <>
+struct ElementTraits<Record>
+{
+	typedef uint64_t Key;
+	static const char* name() { return "record"; }
+	static Key key(const Record& record) { return ElementTraits<long long>::key(record.key); }
+	static Record random(std::mt19937& generator)
+	{
+		Record record;
+		record.key = ElementTraits<long long>::random(generator);
+		record.value = (long long)generator();
+		return record;
+	}
+	static Record fromKey(int k) { return Record{ k, 0 }; }
+};
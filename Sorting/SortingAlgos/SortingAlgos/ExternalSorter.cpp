@@ -0,0 +1,313 @@
+#include "ExternalSorter.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include "ElementTypes.h"
+#include "TextIO.h"
+#include "Timer.h"
+
+namespace
+{
+	// Buffered sequential reader of a binary run file
+	template <typename T>
+	class RunReader
+	{
+	public:
+		bool open(const std::string& filename, size_t capacity)
+		{
+			input.open(filename, std::ios::binary);
+			buffer.resize(capacity);
+			position = 0;
+			filled = 0;
+			return input.is_open();
+		}
+
+		bool next(T& value)
+		{
+			if (position == filled)
+			{
+				input.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(T));
+				filled = (size_t)input.gcount() / sizeof(T);
+				position = 0;
+				if (filled == 0)
+				{
+					return false;
+				}
+			}
+			value = buffer[position++];
+			return true;
+		}
+
+	private:
+		std::ifstream input;
+		std::vector<T> buffer;
+		size_t position = 0;
+		size_t filled = 0;
+	};
+
+	void removeFiles(const std::vector<std::string>& files)
+	{
+		for (const std::string& file : files)
+		{
+			std::remove(file.c_str());
+		}
+	}
+}
+
+template <typename T>
+ExternalSorter<T>::ExternalSorter(size_t memoryBytes, const std::string& tempDirectory)
+	: memory_bytes(memoryBytes), temp_directory(tempDirectory), temp_count(0),
+	elements(0), runs(0), merge_passes(0), run_ms(0.0), merge_ms(0.0)
+{
+	// Unique prefix, so that several sorts can share a directory
+	std::ostringstream prefix;
+	prefix << "extsort_" << std::hex << std::random_device{}() << "_";
+	temp_prefix = prefix.str();
+}
+
+template <typename T>
+std::string ExternalSorter<T>::tempFile()
+{
+	return run_directory + "/" + temp_prefix + std::to_string(temp_count++) + ".run";
+}
+
+template <typename T>
+int ExternalSorter<T>::sortFile(const std::string& inputFile, const std::string& outputFile)
+{
+	elements = 0;
+	runs = 0;
+	merge_passes = 0;
+	run_ms = 0.0;
+	merge_ms = 0.0;
+
+	std::ifstream input(inputFile);
+	if (!input.is_open())
+	{
+		std::cerr << "File failed to open" << std::endl;
+		return 1;
+	}
+	long long count;
+	if (!(input >> count) || count < 0)
+	{
+		std::cerr << "Invalid file format" << std::endl;
+		return 2;
+	}
+	elements = count;
+
+	run_directory = temp_directory;
+	if (run_directory.empty())
+	{
+		size_t slash = outputFile.find_last_of("/\\");
+		run_directory = slash == std::string::npos ? "." : outputFile.substr(0, slash);
+	}
+
+	Timer timer;
+	timer.reset();
+	timer.start();
+	std::vector<std::string> runFiles;
+	int status = createRuns(input, count, runFiles);
+	timer.stop();
+	run_ms = timer.resultNs() / 1e6;
+	runs = (int)runFiles.size();
+	if (status != 0)
+	{
+		removeFiles(runFiles);
+		return status;
+	}
+
+	timer.reset();
+	timer.start();
+
+	// Merge groups of fanIn runs until a single pass can take all of them
+	int fanIn = std::max(2, (int)std::min<size_t>(memory_bytes / sizeof(T) / MIN_RUN_BUFFER, INT_MAX) - 1);
+	while ((int)runFiles.size() > fanIn)
+	{
+		merge_passes++;
+		std::vector<std::string> merged;
+		for (size_t first = 0; first < runFiles.size(); first += fanIn)
+		{
+			size_t last = std::min(first + fanIn, runFiles.size());
+			std::vector<std::string> group(runFiles.begin() + first, runFiles.begin() + last);
+			std::string name = tempFile();
+			merged.push_back(name);
+
+			std::ofstream run(name, std::ios::binary);
+			status = run.is_open() ? mergeRuns(group, run, false) : 3;
+			run.close();
+			removeFiles(group);
+			if (status != 0)
+			{
+				std::cerr << "Failed to write run file: " << name << std::endl;
+				removeFiles(std::vector<std::string>(runFiles.begin() + last, runFiles.end()));
+				removeFiles(merged);
+				return 3;
+			}
+		}
+		runFiles = merged;
+	}
+
+	std::ofstream output(outputFile);
+	if (!output.is_open())
+	{
+		std::cerr << "Failed to open file for writing: " << outputFile << std::endl;
+		removeFiles(runFiles);
+		return 2;
+	}
+
+	// Same layout as Fileloader::SaveToFile
+	output << count << "\n";
+	merge_passes++;
+	status = mergeRuns(runFiles, output, true);
+	output << "\n";
+	removeFiles(runFiles);
+	timer.stop();
+	merge_ms = timer.resultNs() / 1e6;
+
+	if (status != 0 || !output)
+	{
+		std::cerr << "Failed to write output file: " << outputFile << std::endl;
+		return 3;
+	}
+	std::cout << "Array saved to: " << outputFile << std::endl;
+	return 0;
+}
+
+// Reads chunks that fit the memory budget, sorts them and writes each one as a binary run
+template <typename T>
+int ExternalSorter<T>::createRuns(std::istream& input, long long count, std::vector<std::string>& runFiles)
+{
+	size_t chunk = std::max<size_t>(memory_bytes / sizeof(T), MIN_RUN_BUFFER);
+	chunk = std::min<size_t>(chunk, INT_MAX);
+	std::vector<T> buffer((size_t)std::min<long long>(count, (long long)chunk));
+
+	for (long long remaining = count; remaining > 0; )
+	{
+		int size = (int)std::min<long long>(remaining, (long long)chunk);
+		for (int i = 0; i < size; i++)
+		{
+			if (!(input >> buffer[i]))
+			{
+				std::cerr << "Invalid file format" << std::endl;
+				return 2;
+			}
+		}
+		sorter.quickSort(buffer.data(), size, PivotStrategy::MedianOfThree);
+
+		std::string name = tempFile();
+		runFiles.push_back(name);
+		std::ofstream run(name, std::ios::binary);
+		run.write(reinterpret_cast<const char*>(buffer.data()), (std::streamsize)size * sizeof(T));
+		if (!run)
+		{
+			std::cerr << "Failed to write run file: " << name << std::endl;
+			return 3;
+		}
+		remaining -= size;
+	}
+	return 0;
+}
+
+// k-way merge with a loser tree: tree[0] holds the run with the smallest
+// current element, every inner node the run that lost the match there.
+// After the winner advances only its path to the root is replayed (log k comparisons).
+// Ties go to the lower run index, i.e. the earlier part of the input.
+template <typename T>
+int ExternalSorter<T>::mergeRuns(const std::vector<std::string>& runFiles, std::ostream& output, bool text)
+{
+	int k = (int)runFiles.size();
+	if (k == 0)
+	{
+		return 0;
+	}
+	size_t bufferSize = std::max<size_t>(memory_bytes / sizeof(T) / (k + 1), MIN_RUN_BUFFER);
+
+	std::vector<RunReader<T>> readers(k);
+	std::vector<T> current(k);
+	std::vector<char> exhausted(k);
+	for (int i = 0; i < k; i++)
+	{
+		if (!readers[i].open(runFiles[i], bufferSize))
+		{
+			std::cerr << "Failed to open run file: " << runFiles[i] << std::endl;
+			return 1;
+		}
+		exhausted[i] = !readers[i].next(current[i]);
+	}
+
+	auto less = [&](int a, int b) {
+		if (exhausted[a] || exhausted[b])
+		{
+			return !exhausted[a];
+		}
+		if (current[a] < current[b])
+		{
+			return true;
+		}
+		return !(current[b] < current[a]) && a < b;
+	};
+
+	// Leaf s sits at position k + s; while building, the first run to reach a node waits there
+	std::vector<int> tree(k, -1);
+	auto replay = [&](int run) {
+		for (int node = (run + k) / 2; node > 0; node /= 2)
+		{
+			if (tree[node] == -1)
+			{
+				tree[node] = run;
+				return;
+			}
+			if (less(tree[node], run))
+			{
+				std::swap(run, tree[node]);
+			}
+		}
+		tree[0] = run;
+	};
+	for (int run = 0; run < k; run++)
+	{
+		replay(run);
+	}
+
+	std::vector<T> pending;
+	if (!text)
+	{
+		pending.reserve(bufferSize);
+	}
+	TextWriter writer(output, text ? bufferSize * 8 : 64);
+	while (!exhausted[tree[0]])
+	{
+		int winner = tree[0];
+		if (text)
+		{
+			writer.write(current[winner]);
+			writer.put(' ');
+		}
+		else
+		{
+			pending.push_back(current[winner]);
+			if (pending.size() == bufferSize)
+			{
+				output.write(reinterpret_cast<const char*>(pending.data()), (std::streamsize)pending.size() * sizeof(T));
+				pending.clear();
+			}
+		}
+		exhausted[winner] = !readers[winner].next(current[winner]);
+		replay(winner);
+	}
+	if (!pending.empty())
+	{
+		output.write(reinterpret_cast<const char*>(pending.data()), (std::streamsize)pending.size() * sizeof(T));
+	}
+	writer.flush();
+	return output ? 0 : 1;
+}
+
+template class ExternalSorter<int>;
+template class ExternalSorter<long long>;
+template class ExternalSorter<float>;
+template class ExternalSorter<double>;
+template class ExternalSorter<Record>;
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Sorter.h"
+
+// Sorts text files that do not fit in memory (same format as Fileloader:
+// element count, then the elements). The input is read in chunks that fit
+// the memory budget, every chunk is sorted by Sorter and written to a binary
+// run file, and the runs are merged with a loser tree. When there are more
+// runs than the budget can buffer at once, they are merged in several passes.
+// The result is written the way Fileloader::SaveToFile writes it.
+// Instantiated for int, long long, float, double and Record.
+template <typename T>
+class ExternalSorter
+{
+public:
+	// tempDirectory empty means the directory of the output file
+	ExternalSorter(size_t memoryBytes, const std::string& tempDirectory = "");
+
+	// Returns 0 on success, like Fileloader
+	int sortFile(const std::string& inputFile, const std::string& outputFile);
+
+	// Statistics of the last sortFile
+	long long getElements() const { return elements; }
+	int getRuns() const { return runs; }
+	int getMergePasses() const { return merge_passes; }
+	double getRunTimeMs() const { return run_ms; }
+	double getMergeTimeMs() const { return merge_ms; }
+
+	// Smallest read buffer given to a single run during a merge
+	static const int MIN_RUN_BUFFER = 4096;
+
+private:
+	size_t memory_bytes;
+	std::string temp_directory;
+	std::string run_directory;	// temp_directory or the directory of the current output
+	std::string temp_prefix;
+	int temp_count;
+	Sorter<T> sorter;
+
+	long long elements;
+	int runs;
+	int merge_passes;
+	double run_ms;
+	double merge_ms;
+
+	int createRuns(std::istream& input, long long count, std::vector<std::string>& runFiles);
+	int mergeRuns(const std::vector<std::string>& runFiles, std::ostream& output, bool text);
+	std::string tempFile();
+};
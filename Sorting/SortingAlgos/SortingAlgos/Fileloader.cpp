@@ -0,0 +1,207 @@
+#include "Fileloader.h"
+#include <climits>
+#include <cstring>
+#include "MappedFile.h"
+#include "TextIO.h"
+#include "Timer.h"
+
+namespace
+{
+	// Binary layout: header, then size raw elements
+	struct BinaryHeader
+	{
+		char magic[8];	// "SORTBIN1"
+		char type[8];	// ElementTraits<T>::name(), zero padded
+		long long size;
+	};
+
+	const char BINARY_MAGIC[8] = { 'S', 'O', 'R', 'T', 'B', 'I', 'N', '1' };
+
+	bool hasBinaryHeader(const char* data, size_t length)
+	{
+		return length >= sizeof(BinaryHeader) && std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+	}
+
+	bool endsWith(const std::string& text, const std::string& suffix)
+	{
+		return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+	}
+
+	void reportThroughput(const char* action, long long bytes, long long ns)
+	{
+		double megabytes = bytes / (1024.0 * 1024.0);
+		double ms = ns / 1e6;
+		std::cout << action << " " << megabytes << " MB in " << ms << " ms";
+		if (ns > 0)
+		{
+			std::cout << " (" << megabytes / (ns / 1e9) << " MB/s)";
+		}
+		std::cout << std::endl;
+	}
+}
+
+template <typename T>
+int Fileloader<T>::LoadFile(const std::string filename)
+{
+	MappedFile file;
+	if (!file.open(filename))
+	{
+		std::cerr << "File failed to open" << std::endl;
+		return 1; //file not found
+	}
+
+	std::cout << "Reading file..." << std::endl;
+	delete[] array;		// reloading replaces the previous array
+	array = nullptr;
+	size = 0;
+
+	Timer timer;
+	timer.reset();
+	timer.start();
+	int status = hasBinaryHeader(file.data(), file.size())
+		? loadBinary(file.data(), file.size())
+		: loadText(file.data(), file.size());
+	timer.stop();
+
+	if (status == 0)
+	{
+		reportThroughput("Read", (long long)file.size(), timer.resultNs());
+	}
+	return status;
+}
+
+template <typename T>
+int Fileloader<T>::loadText(const char* data, size_t length)
+{
+	TextReader reader(data, data + length);
+	long long count;
+	if (!reader.read(count) || count < 0 || count > INT_MAX)
+	{
+		std::cerr << "Invalid file format" << std::endl;
+		return 2;
+	}
+
+	size = (int)count;
+	array = new T[size];
+	for (int i = 0; i < size; i++)
+	{
+		if (!reader.read(array[i]))
+		{
+			std::cerr << "Error reading value at index " << i << std::endl;
+			delete[] array;
+			array = nullptr;
+			size = 0;
+			return 2; //error reading value
+		}
+	}
+	return 0;
+}
+
+template <typename T>
+int Fileloader<T>::loadBinary(const char* data, size_t length)
+{
+	BinaryHeader header;
+	std::memcpy(&header, data, sizeof(header));
+
+	char type[sizeof(header.type) + 1] = {};
+	std::memcpy(type, header.type, sizeof(header.type));
+	if (std::strcmp(type, ElementTraits<T>::name()) != 0)
+	{
+		std::cerr << "File holds " << type << " elements, expected " << ElementTraits<T>::name() << std::endl;
+		return 2;
+	}
+	if (header.size < 0 || header.size > INT_MAX
+		|| (length - sizeof(header)) / sizeof(T) < (unsigned long long)header.size)
+	{
+		std::cerr << "Invalid file format" << std::endl;
+		return 2;
+	}
+
+	size = (int)header.size;
+	array = new T[size];
+	std::memcpy(array, data + sizeof(header), (size_t)size * sizeof(T));
+	return 0;
+}
+
+template <typename T>
+int Fileloader<T>::SaveToFile(const std::string& filename) const
+{
+	if (array == nullptr || size == 0)
+	{
+		std::cerr << "Nothing to save. Array is empty or not loaded." << std::endl;
+		return 1;
+	}
+
+	bool binary = endsWith(filename, ".bin");
+	std::ofstream outfile(filename, binary ? std::ios::binary : std::ios::out);
+	if (!outfile.is_open())
+	{
+		std::cerr << "Failed to open file for writing: " << filename << std::endl;
+		return 2;
+	}
+
+	Timer timer;
+	timer.reset();
+	timer.start();
+	long long bytes;
+	if (binary)
+	{
+		BinaryHeader header = {};
+		std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+		std::strncpy(header.type, ElementTraits<T>::name(), sizeof(header.type));
+		header.size = size;
+		outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		outfile.write(reinterpret_cast<const char*>(array), (std::streamsize)size * sizeof(T));
+		bytes = (long long)sizeof(header) + (long long)size * sizeof(T);
+	}
+	else
+	{
+		// Size first, then the values; floating point values are written
+		// with the shortest form that reads back unchanged
+		TextWriter writer(outfile);
+		writer.write(size);
+		writer.put('\n');
+		for (int i = 0; i < size; i++)
+		{
+			writer.write(array[i]);
+			writer.put(' ');
+		}
+		writer.put('\n');
+		writer.flush();
+		bytes = writer.bytesWritten();
+	}
+	outfile.close();
+	timer.stop();
+
+	if (!outfile)
+	{
+		std::cerr << "Failed to write file: " << filename << std::endl;
+		return 2;
+	}
+	reportThroughput("Wrote", bytes, timer.resultNs());
+	std::cout << "Array saved to: " << filename << std::endl;
+	return 0;
+}
+
+template <typename T>
+void Fileloader<T>::DisplayArray() const
+{
+	if (array == nullptr || size == 0)
+	{
+		std::cout << "Array is empty or not loaded." << std::endl;
+		return;
+	}
+
+	std::cout << "Array contents:" << std::endl;
+	for (int i = 0; i < size; i++)
+	{
+		std::cout << array[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+template class Fileloader<int>;
+template class Fileloader<long long>;
+template class Fileloader<float>;
+template class Fileloader<double>;
+template class Fileloader<Record>;
@@ -0,0 +1,35 @@
+#pragma once
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "ElementTypes.h"
+
+// Loads an array from a text file (element count, then the elements)
+// and saves it back in the same format. Owns the loaded buffer.
+// Files are read through a memory map; files starting with the binary
+// header (written by SaveToFile for names ending in ".bin") hold the raw
+// array and are copied in directly. Both directions print their throughput.
+// Instantiated for int, long long, float, double and Record.
+template <typename T>
+class Fileloader
+{
+public:
+	Fileloader() = default;
+	~Fileloader() { delete[] array; }
+
+	Fileloader(const Fileloader&) = delete;
+	Fileloader& operator=(const Fileloader&) = delete;
+
+	T* array = nullptr;
+	int size = 0;
+	int LoadFile(const std::string filename);
+	int SaveToFile(const std::string& filename) const;
+	void DisplayArray() const;
+
+private:
+	int loadText(const char* data, size_t length);
+	int loadBinary(const char* data, size_t length);
+
+
+
+};
@@ -0,0 +1,121 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+	HANDLE handle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	file = handle;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(handle, &fileSize))
+	{
+		close();
+		return false;
+	}
+	length = (size_t)fileSize.QuadPart;
+	if (length == 0)
+	{
+		return true;
+	}
+
+	mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		close();
+		return false;
+	}
+	contents = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (contents == nullptr)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (contents != nullptr)
+	{
+		UnmapViewOfFile(contents);
+	}
+	if (mapping != nullptr)
+	{
+		CloseHandle(mapping);
+	}
+	if (file != nullptr)
+	{
+		CloseHandle(file);
+	}
+	contents = nullptr;
+	mapping = nullptr;
+	file = nullptr;
+	length = 0;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+	int descriptor = ::open(filename.c_str(), O_RDONLY);
+	if (descriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(descriptor, &info) != 0)
+	{
+		::close(descriptor);
+		return false;
+	}
+	length = (size_t)info.st_size;
+	if (length == 0)
+	{
+		::close(descriptor);
+		return true;
+	}
+
+	// The mapping keeps its own reference to the file
+	void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	::close(descriptor);
+	if (address == MAP_FAILED)
+	{
+		length = 0;
+		return false;
+	}
+	madvise(address, length, MADV_SEQUENTIAL);
+	contents = (const char*)address;
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (contents != nullptr)
+	{
+		munmap((void*)contents, length);
+	}
+	contents = nullptr;
+	length = 0;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only memory map of a whole file (mmap, or a file mapping on Windows).
+// The contents stay valid until close() or destruction.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile() { close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Returns false when the file cannot be opened or mapped; an empty file maps to size 0
+	bool open(const std::string& filename);
+	void close();
+
+	const char* data() const { return contents; }
+	size_t size() const { return length; }
+
+private:
+	const char* contents = nullptr;
+	size_t length = 0;
+#ifdef _WIN32
+	void* file = nullptr;
+	void* mapping = nullptr;
+#endif
+};
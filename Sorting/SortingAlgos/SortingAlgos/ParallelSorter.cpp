@@ -0,0 +1,156 @@
+#include "ParallelSorter.h"
+#include "ElementTypes.h"
+#include <algorithm>
+#include <utility>
+
+template <typename T>
+ParallelSorter<T>::ParallelSorter(int threads)
+	: pool(threads), sorters(pool.getThreads())
+{
+}
+
+template <typename T>
+void ParallelSorter<T>::quickSort(T* array, int size)
+{
+	quickRange(array, size);
+}
+
+template <typename T>
+void ParallelSorter<T>::quickRange(T* array, int size)
+{
+	ThreadPool::TaskGroup group;
+
+	// The left part becomes a task, the right one is partitioned further here
+	while (size > SEQUENTIAL_CUTOFF)
+	{
+		int split = partition(array, size) + 1;
+		pool.submit(group, [this, array, split] { quickRange(array, split); });
+		array += split;
+		size -= split;
+	}
+	sorters[pool.currentIndex()].quickSort(array, size, PivotStrategy::MedianOfThree);
+
+	pool.wait(group);
+}
+
+// Hoare partition around the median of three; returns split such that
+// [0, split] <= pivot <= [split + 1, size), with 0 <= split < size - 1
+template <typename T>
+int ParallelSorter<T>::partition(T* array, int size)
+{
+	int middle = size / 2;
+	int last = size - 1;
+	int median;
+	if (array[0] < array[middle])
+	{
+		median = array[middle] < array[last] ? middle : (array[0] < array[last] ? last : 0);
+	}
+	else
+	{
+		median = array[0] < array[last] ? 0 : (array[middle] < array[last] ? last : middle);
+	}
+	// The pivot is moved to the front, which keeps both parts non-empty
+	std::swap(array[0], array[median]);
+	T value = array[0];
+
+	int i = -1;
+	int j = size;
+	while (true)
+	{
+		do { i++; } while (array[i] < value);
+		do { j--; } while (value < array[j]);
+		if (i >= j)
+		{
+			return j;
+		}
+		std::swap(array[i], array[j]);
+	}
+}
+
+template <typename T>
+void ParallelSorter<T>::mergeSort(T* array, int size)
+{
+	if ((int)scratch.size() < size)
+	{
+		scratch.resize(size);
+	}
+	mergeRange(array, scratch.data(), size, false);
+}
+
+// Sorts array[0, size); the result ends in buffer when toBuffer is set, otherwise in array.
+// Halves are sorted into the opposite buffer, so the merge never needs an extra copy.
+template <typename T>
+void ParallelSorter<T>::mergeRange(T* array, T* buffer, int size, bool toBuffer)
+{
+	// Short runs go to Sorter::smallSort: insertion sort is stable, and the
+	// network only handles int and float, whose equal elements are indistinguishable
+	if (size <= Sorter<T>::SMALL_SORT_SIZE)
+	{
+		sorters[pool.currentIndex()].smallSort(array, size);
+		if (toBuffer)
+		{
+			std::copy(array, array + size, buffer);
+		}
+		return;
+	}
+
+	int half = size / 2;
+	if (size <= SEQUENTIAL_CUTOFF)
+	{
+		mergeRange(array, buffer, half, !toBuffer);
+		mergeRange(array + half, buffer + half, size - half, !toBuffer);
+	}
+	else
+	{
+		ThreadPool::TaskGroup group;
+		pool.submit(group, [this, array, buffer, half, toBuffer] { mergeRange(array, buffer, half, !toBuffer); });
+		mergeRange(array + half, buffer + half, size - half, !toBuffer);
+		pool.wait(group);
+	}
+
+	const T* from = toBuffer ? array : buffer;
+	T* to = toBuffer ? buffer : array;
+	merge(from, half, from + half, size - half, to);
+}
+
+// Stable merge of two sorted runs. Long merges split the larger run at its middle,
+// find the matching position in the other run by binary search and merge both
+// halves in parallel.
+template <typename T>
+void ParallelSorter<T>::merge(const T* left, int leftSize, const T* right, int rightSize, T* output)
+{
+	if (leftSize + rightSize <= MERGE_CUTOFF)
+	{
+		std::merge(left, left + leftSize, right, right + rightSize, output);
+		return;
+	}
+
+	int leftSplit;
+	int rightSplit;
+	if (leftSize >= rightSize)
+	{
+		leftSplit = leftSize / 2;
+		// Equal elements of the right run stay behind the split element
+		rightSplit = (int)(std::lower_bound(right, right + rightSize, left[leftSplit]) - right);
+	}
+	else
+	{
+		rightSplit = rightSize / 2;
+		// Equal elements of the left run stay in front of the split element
+		leftSplit = (int)(std::upper_bound(left, left + leftSize, right[rightSplit]) - left);
+	}
+
+	ThreadPool::TaskGroup group;
+	pool.submit(group, [this, left, leftSplit, right, rightSplit, output] {
+		merge(left, leftSplit, right, rightSplit, output);
+	});
+	merge(left + leftSplit, leftSize - leftSplit, right + rightSplit, rightSize - rightSplit,
+		output + leftSplit + rightSplit);
+	pool.wait(group);
+}
+
+template class ParallelSorter<int>;
+template class ParallelSorter<long long>;
+template class ParallelSorter<float>;
+template class ParallelSorter<double>;
+template class ParallelSorter<Record>;
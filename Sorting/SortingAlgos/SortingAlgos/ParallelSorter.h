@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include "Sorter.h"
+#include "ThreadPool.h"
+
+// Multithreaded sorting on a work-stealing ThreadPool.
+// Ranges shorter than SEQUENTIAL_CUTOFF are sorted by the Sorter of the
+// thread that picked them up, merges shorter than MERGE_CUTOFF run sequentially.
+template <typename T>
+class ParallelSorter
+{
+public:
+	// threads includes the calling thread, 0 means hardware concurrency
+	ParallelSorter(int threads = 0);
+
+	void quickSort(T* array, int size);
+	// Stable, needs a scratch buffer of size elements (kept between calls)
+	void mergeSort(T* array, int size);
+
+	int getThreads() const { return pool.getThreads(); }
+
+	static const int SEQUENTIAL_CUTOFF = 1 << 14;
+	static const int MERGE_CUTOFF = 1 << 14;
+
+private:
+	ThreadPool pool;
+	std::vector<Sorter<T>> sorters;	// one per pool thread
+	std::vector<T> scratch;
+
+	void quickRange(T* array, int size);
+	void mergeRange(T* array, T* buffer, int size, bool toBuffer);
+	void merge(const T* left, int leftSize, const T* right, int rightSize, T* output);
+	static int partition(T* array, int size);
+};
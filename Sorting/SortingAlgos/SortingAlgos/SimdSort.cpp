@@ -0,0 +1,364 @@
+#include "SimdSort.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SIMD_TARGET
+#else
+#define SIMD_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+#ifdef SIMD_X86
+	// Partition of a few leftover elements into the free gap [storeLeft, storeRight)
+	template <typename T>
+	int placeScalar(const T* values, int count, T* array, int storeLeft, int storeRight, T pivot, bool strict)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			bool goesLeft = strict ? values[i] < pivot : values[i] <= pivot;
+			if (goesLeft)
+			{
+				array[storeLeft++] = values[i];
+			}
+			else
+			{
+				array[--storeRight] = values[i];
+			}
+		}
+		return storeLeft;
+	}
+
+	bool detectAvx2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+		{
+			return false;
+		}
+		// AVX needs OS support for saving the ymm registers
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+		{
+			return false;
+		}
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+
+	struct IntOps
+	{
+		typedef int Scalar;
+		typedef __m256i Vec;
+
+		static SIMD_TARGET Vec load(const int* p) { return _mm256_loadu_si256((const __m256i*)p); }
+		static SIMD_TARGET void store(int* p, Vec v) { _mm256_storeu_si256((__m256i*)p, v); }
+		static SIMD_TARGET Vec set1(int value) { return _mm256_set1_epi32(value); }
+		static SIMD_TARGET Vec min(Vec a, Vec b) { return _mm256_min_epi32(a, b); }
+		static SIMD_TARGET Vec max(Vec a, Vec b) { return _mm256_max_epi32(a, b); }
+		static SIMD_TARGET Vec permute(Vec v, __m256i index) { return _mm256_permutevar8x32_epi32(v, index); }
+		template <int mask>
+		static SIMD_TARGET Vec blend(Vec a, Vec b) { return _mm256_blend_epi32(a, b, mask); }
+		// Bit i set when lane i belongs to the left part
+		static SIMD_TARGET int leftMask(Vec v, Vec pivot, bool strict)
+		{
+			if (strict)
+			{
+				return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, v)));
+			}
+			return ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, pivot))) & 0xFF;
+		}
+		static int highest() { return std::numeric_limits<int>::max(); }
+	};
+
+	struct FloatOps
+	{
+		typedef float Scalar;
+		typedef __m256 Vec;
+
+		static SIMD_TARGET Vec load(const float* p) { return _mm256_loadu_ps(p); }
+		static SIMD_TARGET void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+		static SIMD_TARGET Vec set1(float value) { return _mm256_set1_ps(value); }
+		static SIMD_TARGET Vec min(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+		static SIMD_TARGET Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+		static SIMD_TARGET Vec permute(Vec v, __m256i index) { return _mm256_permutevar8x32_ps(v, index); }
+		template <int mask>
+		static SIMD_TARGET Vec blend(Vec a, Vec b) { return _mm256_blend_ps(a, b, mask); }
+		static SIMD_TARGET int leftMask(Vec v, Vec pivot, bool strict)
+		{
+			if (strict)
+			{
+				return _mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_LT_OQ));
+			}
+			return _mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_LE_OQ));
+		}
+		static float highest() { return std::numeric_limits<float>::infinity(); }
+	};
+
+	// For every lane mask: indices of the left lanes followed by the right lanes
+	struct PartitionTable
+	{
+		int index[256][8];
+		int count[256];
+
+		PartitionTable()
+		{
+			for (int mask = 0; mask < 256; mask++)
+			{
+				int k = 0;
+				for (int lane = 0; lane < 8; lane++)
+				{
+					if (mask & (1 << lane))
+					{
+						index[mask][k++] = lane;
+					}
+				}
+				count[mask] = k;
+				for (int lane = 0; lane < 8; lane++)
+				{
+					if (!(mask & (1 << lane)))
+					{
+						index[mask][k++] = lane;
+					}
+				}
+			}
+		}
+	};
+
+	const PartitionTable partitionTable;
+
+	// Lane permutations of the in-register network steps
+	SIMD_TARGET __m256i swap1() { return _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6); }
+	SIMD_TARGET __m256i swap2() { return _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5); }
+	SIMD_TARGET __m256i swap4() { return _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3); }
+	SIMD_TARGET __m256i reverse4() { return _mm256_setr_epi32(3, 2, 1, 0, 7, 6, 5, 4); }
+	SIMD_TARGET __m256i reverse8() { return _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0); }
+
+	// Compare-exchange of every lane with its partner; lanes set in mask keep the maximum
+	template <class Ops, int mask>
+	SIMD_TARGET typename Ops::Vec exchange(typename Ops::Vec v, __m256i partner)
+	{
+		typename Ops::Vec other = Ops::permute(v, partner);
+		return Ops::template blend<mask>(Ops::min(v, other), Ops::max(v, other));
+	}
+
+	template <class Ops>
+	SIMD_TARGET typename Ops::Vec sort8(typename Ops::Vec v)
+	{
+		v = exchange<Ops, 0xAA>(v, swap1());
+		v = exchange<Ops, 0xCC>(v, reverse4());
+		v = exchange<Ops, 0xAA>(v, swap1());
+		v = exchange<Ops, 0xF0>(v, reverse8());
+		v = exchange<Ops, 0xCC>(v, swap2());
+		v = exchange<Ops, 0xAA>(v, swap1());
+		return v;
+	}
+
+	// Sorts a bitonic register
+	template <class Ops>
+	SIMD_TARGET typename Ops::Vec clean8(typename Ops::Vec v)
+	{
+		v = exchange<Ops, 0xF0>(v, swap4());
+		v = exchange<Ops, 0xCC>(v, swap2());
+		v = exchange<Ops, 0xAA>(v, swap1());
+		return v;
+	}
+
+	// Bitonic sort of count (1, 2 or 4) registers seen as one sequence
+	template <class Ops>
+	SIMD_TARGET void sortRegisters(typename Ops::Vec* v, int count)
+	{
+		typedef typename Ops::Vec Vec;
+
+		for (int i = 0; i < count; i++)
+		{
+			v[i] = sort8<Ops>(v[i]);
+		}
+		for (int width = 2; width <= count; width *= 2)
+		{
+			for (int block = 0; block < count; block += width)
+			{
+				// Each element of the lower half meets its mirror in the upper half
+				int half = width / 2;
+				for (int i = 0; i < half; i++)
+				{
+					Vec mirror = Ops::permute(v[block + width - 1 - i], reverse8());
+					Vec low = Ops::min(v[block + i], mirror);
+					Vec high = Ops::max(v[block + i], mirror);
+					v[block + i] = low;
+					v[block + width - 1 - i] = Ops::permute(high, reverse8());
+				}
+				// Half cleaners across registers, then inside them
+				for (int distance = half / 2; distance >= 1; distance /= 2)
+				{
+					for (int i = block; i < block + width; i++)
+					{
+						if (((i - block) & distance) == 0)
+						{
+							Vec low = Ops::min(v[i], v[i + distance]);
+							Vec high = Ops::max(v[i], v[i + distance]);
+							v[i] = low;
+							v[i + distance] = high;
+						}
+					}
+				}
+				for (int i = block; i < block + width; i++)
+				{
+					v[i] = clean8<Ops>(v[i]);
+				}
+			}
+		}
+	}
+
+	template <class Ops>
+	SIMD_TARGET void sortNetwork(typename Ops::Scalar* array, int size)
+	{
+		typedef typename Ops::Scalar Scalar;
+
+		int registers = size <= 8 ? 1 : (size <= 16 ? 2 : 4);
+		Scalar buffer[32];
+		std::copy(array, array + size, buffer);
+		std::fill(buffer + size, buffer + registers * 8, Ops::highest());
+
+		typename Ops::Vec v[4];
+		for (int i = 0; i < registers; i++)
+		{
+			v[i] = Ops::load(buffer + i * 8);
+		}
+		sortRegisters<Ops>(v, registers);
+		for (int i = 0; i < registers; i++)
+		{
+			Ops::store(buffer + i * 8, v[i]);
+		}
+		std::copy(buffer, buffer + size, array);
+	}
+
+	// In-place partition: the first and the last vector are kept in registers,
+	// which leaves at least 8 free slots on the side that is written next.
+	// Every loaded vector is permuted so that its left lanes come first, then
+	// stored whole at both write positions; the lanes past the written count
+	// land in space that has already been read.
+	template <class Ops>
+	SIMD_TARGET int partition(typename Ops::Scalar* array, int size, typename Ops::Scalar pivot, bool strict)
+	{
+		typedef typename Ops::Scalar Scalar;
+		typedef typename Ops::Vec Vec;
+
+		Scalar rest[24];
+		if (size < 16)
+		{
+			std::copy(array, array + size, rest);
+			return placeScalar(rest, size, array, 0, size, pivot, strict);
+		}
+
+		Vec pivots = Ops::set1(pivot);
+		Vec first = Ops::load(array);
+		Vec last = Ops::load(array + size - 8);
+		int readLeft = 8;
+		int readRight = size - 8;
+		int storeLeft = 0;
+		int storeRight = size;
+
+		while (readRight - readLeft >= 8)
+		{
+			Vec v;
+			if (readLeft - storeLeft <= storeRight - readRight)
+			{
+				v = Ops::load(array + readLeft);
+				readLeft += 8;
+			}
+			else
+			{
+				readRight -= 8;
+				v = Ops::load(array + readRight);
+			}
+
+			int mask = Ops::leftMask(v, pivots, strict);
+			v = Ops::permute(v, _mm256_loadu_si256((const __m256i*)partitionTable.index[mask]));
+			int count = partitionTable.count[mask];
+			Ops::store(array + storeLeft, v);
+			Ops::store(array + storeRight - 8, v);
+			storeLeft += count;
+			storeRight -= 8 - count;
+		}
+
+		// The unread middle and both kept vectors fill the gap that is left
+		int remaining = readRight - readLeft;
+		std::copy(array + readLeft, array + readRight, rest);
+		Ops::store(rest + remaining, first);
+		Ops::store(rest + remaining + 8, last);
+		return placeScalar(rest, remaining + 16, array, storeLeft, storeRight, pivot, strict);
+	}
+#endif
+}
+
+bool simdAvailable()
+{
+#ifdef SIMD_X86
+	static const bool available = detectAvx2();
+	return available;
+#else
+	return false;
+#endif
+}
+
+#ifdef SIMD_X86
+
+void SimdKernel<int>::sortNetwork(int* array, int size)
+{
+	::sortNetwork<IntOps>(array, size);
+}
+
+int SimdKernel<int>::partition(int* array, int size, int pivot, bool strict)
+{
+	return ::partition<IntOps>(array, size, pivot, strict);
+}
+
+void SimdKernel<float>::sortNetwork(float* array, int size)
+{
+	::sortNetwork<FloatOps>(array, size);
+}
+
+int SimdKernel<float>::partition(float* array, int size, float pivot, bool strict)
+{
+	return ::partition<FloatOps>(array, size, pivot, strict);
+}
+
+#else
+
+// Without x86 the kernels are never selected; plain versions keep the build linking
+
+void SimdKernel<int>::sortNetwork(int* array, int size)
+{
+	std::sort(array, array + size);
+}
+
+int SimdKernel<int>::partition(int* array, int size, int pivot, bool strict)
+{
+	return (int)(std::partition(array, array + size, [=](int x) { return strict ? x < pivot : x <= pivot; }) - array);
+}
+
+void SimdKernel<float>::sortNetwork(float* array, int size)
+{
+	std::sort(array, array + size);
+}
+
+int SimdKernel<float>::partition(float* array, int size, float pivot, bool strict)
+{
+	return (int)(std::partition(array, array + size, [=](float x) { return strict ? x < pivot : x <= pivot; }) - array);
+}
+
+#endif
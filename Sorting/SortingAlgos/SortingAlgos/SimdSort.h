@@ -0,0 +1,37 @@
+#pragma once
+
+// AVX2 kernels used by Sorter for int and float arrays.
+// They are compiled for AVX2 regardless of the build flags and are only
+// called when simdAvailable() confirmed the instruction set at runtime.
+
+// CPU (and OS) support for AVX2, detected once
+bool simdAvailable();
+
+// Types without vector kernels; Sorter never enables SIMD for them
+template <typename T>
+struct SimdKernel
+{
+	static const bool supported = false;
+	static void sortNetwork(T*, int) {}
+	static int partition(T*, int size, T, bool) { return size; }
+};
+
+// sortNetwork sorts up to 32 elements with a bitonic sorting network
+// (8, 16 or 32 lanes, padded with the largest value).
+// partition moves the elements <= pivot (< pivot when strict) to the front
+// and returns their count; the order inside both parts is unspecified.
+template <>
+struct SimdKernel<int>
+{
+	static const bool supported = true;
+	static void sortNetwork(int* array, int size);
+	static int partition(int* array, int size, int pivot, bool strict);
+};
+
+template <>
+struct SimdKernel<float>
+{
+	static const bool supported = true;
+	static void sortNetwork(float* array, int size);
+	static int partition(float* array, int size, float pivot, bool strict);
+};
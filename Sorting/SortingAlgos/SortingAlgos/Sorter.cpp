@@ -0,0 +1,822 @@
+#include "Sorter.h"
+#include "ElementTypes.h"
+#include "TopK.h"
+#include <algorithm>
+#include <utility>
+
+template <typename T>
+void Sorter<T>::insertionSort(T* array, int size)
+{
+	insertionSort(array, 0, size - 1);
+}
+
+template <typename T>
+void Sorter<T>::insertionSort(T* array, int left, int right)
+{
+	for (int i = left + 1; i <= right; i++)
+	{
+		T value = array[i];
+		int j = i - 1;
+		// Shift larger elements one place right instead of swapping
+		while (j >= left && value < array[j])
+		{
+			array[j + 1] = array[j];
+			j--;
+		}
+		array[j + 1] = value;
+	}
+}
+
+template <typename T>
+void Sorter<T>::heapSort(T* array, int size)
+{
+	// Build a max-heap bottom-up
+	for (int i = size / 2 - 1; i >= 0; i--)
+	{
+		siftDown(array, i, size);
+	}
+
+	// Move the maximum behind the shrinking heap
+	for (int end = size - 1; end > 0; end--)
+	{
+		std::swap(array[0], array[end]);
+		siftDown(array, 0, end);
+	}
+}
+
+template <typename T>
+void Sorter<T>::siftDown(T* array, int root, int size)
+{
+	T value = array[root];
+	while (true)
+	{
+		int child = 2 * root + 1;
+		if (child >= size)
+		{
+			break;
+		}
+		if (child + 1 < size && array[child] < array[child + 1])
+		{
+			child++;
+		}
+		if (!(value < array[child]))
+		{
+			break;
+		}
+		array[root] = array[child];
+		root = child;
+	}
+	array[root] = value;
+}
+
+template <typename T>
+void Sorter<T>::shellSort(T* array, int size, GapSequence sequence)
+{
+	int gaps[64];
+	int count = fillGaps(gaps, size, sequence);
+
+	// Gaps are stored ascending, the sort goes from the largest one down to 1
+	for (int g = count - 1; g >= 0; g--)
+	{
+		int gap = gaps[g];
+		for (int i = gap; i < size; i++)
+		{
+			T value = array[i];
+			int j = i;
+			while (j >= gap && value < array[j - gap])
+			{
+				array[j] = array[j - gap];
+				j -= gap;
+			}
+			array[j] = value;
+		}
+	}
+}
+
+// Writes the gaps smaller than size in ascending order, returns their count
+template <typename T>
+int Sorter<T>::fillGaps(int* gaps, int size, GapSequence sequence)
+{
+	int count = 0;
+	gaps[count++] = 1;
+
+	switch (sequence)
+	{
+	case GapSequence::Shell:
+	{
+		// Built from the top so that it matches n/2, n/4, ... exactly
+		int top[64];
+		int topCount = 0;
+		for (int gap = size / 2; gap > 1; gap /= 2)
+		{
+			top[topCount++] = gap;
+		}
+		while (topCount > 0)
+		{
+			gaps[count++] = top[--topCount];
+		}
+		break;
+	}
+	case GapSequence::Knuth:
+		for (long long gap = 4; gap < size / 3 + 1; gap = 3 * gap + 1)
+		{
+			gaps[count++] = (int)gap;
+		}
+		break;
+	case GapSequence::Sedgewick:
+		for (int k = 1; k < 31; k++)
+		{
+			long long gap = (1LL << (2 * k)) + 3 * (1LL << (k - 1)) + 1;
+			if (gap >= size)
+			{
+				break;
+			}
+			gaps[count++] = (int)gap;
+		}
+		break;
+	case GapSequence::Ciura:
+	{
+		static const int ciura[] = { 4, 10, 23, 57, 132, 301, 701 };
+		double gap = 1;
+		for (int known : ciura)
+		{
+			if (known >= size)
+			{
+				return count;
+			}
+			gaps[count++] = known;
+			gap = known;
+		}
+		// Extension of the empirical sequence
+		for (gap *= 2.25; gap < size && count < 64; gap *= 2.25)
+		{
+			gaps[count++] = (int)gap;
+		}
+		break;
+	}
+	}
+	return count;
+}
+
+template <typename T>
+void Sorter<T>::quickSort(T* array, int size, PivotStrategy pivot)
+{
+	int left = 0;
+	int right = size - 1;
+
+	// Recurse into the smaller part and loop on the larger one,
+	// so the stack depth stays O(log n) even for the worst pivot
+	while (right - left >= SMALL_SORT_SIZE)
+	{
+		int split;
+		if (simd)
+		{
+			// Vector partition into <= pivot and > pivot
+			T value = array[choosePivot(array, left, right, pivot)];
+			int length = right - left + 1;
+			int count = SimdKernel<T>::partition(array + left, length, value, false);
+			if (count == length)
+			{
+				// Nothing is greater, so the elements equal to the pivot go behind the rest and stay there
+				right = left + SimdKernel<T>::partition(array + left, length, value, true) - 1;
+				continue;
+			}
+			split = left + count - 1;
+
+			// The vector partition does not keep the order of the input, so a
+			// presorted array can turn into a pattern on which median of three
+			// keeps failing; a few swaps in both parts break it up
+			if (std::min(count, length - count) < length / 8)
+			{
+				breakPatterns(array + left, count);
+				breakPatterns(array + left + count, length - count);
+			}
+		}
+		else
+		{
+			split = partition(array, left, right, pivot);
+		}
+		if (split - left < right - split)
+		{
+			quickSort(array + left, split - left + 1, pivot);
+			left = split + 1;
+		}
+		else
+		{
+			quickSort(array + split + 1, right - split, pivot);
+			right = split;
+		}
+	}
+	if (left < right)
+	{
+		smallSort(array + left, right - left + 1);
+	}
+}
+
+template <typename T>
+void Sorter<T>::breakPatterns(T* array, int size)
+{
+	if (size < SMALL_SORT_SIZE)
+	{
+		return;
+	}
+	int quarter = size / 4;
+	std::swap(array[0], array[quarter]);
+	std::swap(array[size - 1], array[size - quarter]);
+	std::swap(array[1], array[quarter + 1]);
+	std::swap(array[size - 2], array[size - quarter - 1]);
+	std::swap(array[size / 2], array[size / 2 + quarter / 2]);
+}
+
+template <typename T>
+void Sorter<T>::hybridSort(T* array, int size)
+{
+	if (size < 2 || mergeRuns(array, size))
+	{
+		return;
+	}
+	int log = 0;
+	for (int n = size; n > 1; n /= 2)
+	{
+		log++;
+	}
+	hybridLoop(array, 0, size, log, true);
+}
+
+// Splits the array into maximal non-descending and strictly descending runs
+// (the latter reversed in place) and merges them pairwise through the scratch
+// buffer. Gives up early, returning false, once the runs turn out too short.
+template <typename T>
+bool Sorter<T>::mergeRuns(T* array, int size)
+{
+	int maxRuns = size / MIN_AVERAGE_RUN + 1;
+	std::vector<int> bounds;
+	bounds.push_back(0);
+	for (int i = 0; i < size; )
+	{
+		int j = i + 1;
+		if (j < size && array[j] < array[i])
+		{
+			while (j < size && array[j] < array[j - 1])
+			{
+				j++;
+			}
+			std::reverse(array + i, array + j);
+		}
+		else
+		{
+			while (j < size && !(array[j] < array[j - 1]))
+			{
+				j++;
+			}
+		}
+		bounds.push_back(j);
+		if ((int)bounds.size() - 1 > maxRuns)
+		{
+			return false;
+		}
+		i = j;
+	}
+
+	T* from = array;
+	T* to = reserveScratch(size);
+	while (bounds.size() > 2)
+	{
+		std::vector<int> merged;
+		merged.push_back(0);
+		for (size_t r = 0; r + 1 < bounds.size(); r += 2)
+		{
+			int begin = bounds[r];
+			int middle = bounds[r + 1];
+			int end = r + 2 < bounds.size() ? bounds[r + 2] : middle;
+			std::merge(from + begin, from + middle, from + middle, from + end, to + begin);
+			merged.push_back(end);
+		}
+		bounds = merged;
+		std::swap(from, to);
+	}
+	if (from != array)
+	{
+		std::copy(from, from + size, array);
+	}
+	return true;
+}
+
+// Sorts [left, right). badAllowed counts the unbalanced partitions left before
+// heapsort takes over; leftmost tells whether array[left - 1] belongs to the range
+// sorted by hybridSort (if it does, it is not greater than anything in [left, right)).
+template <typename T>
+void Sorter<T>::hybridLoop(T* array, int left, int right, int badAllowed, bool leftmost)
+{
+	while (true)
+	{
+		int size = right - left;
+		if (size <= SMALL_SORT_SIZE)
+		{
+			smallSort(array + left, size);
+			return;
+		}
+
+		pivotToFront(array, left, right);
+
+		// The predecessor equals the pivot: all the pivot copies are put
+		// in front and only the larger elements are left to sort
+		if (!leftmost && !(array[left - 1] < array[left]))
+		{
+			left = partitionEqual(array, left, right) + 1;
+			continue;
+		}
+
+		bool alreadyPartitioned;
+		int pivot = partitionRight(array, left, right, alreadyPartitioned);
+		int leftSize = pivot - left;
+		int rightSize = right - pivot - 1;
+
+		if (leftSize < size / 8 || rightSize < size / 8)
+		{
+			if (--badAllowed == 0)
+			{
+				heapSort(array + left, size);
+				return;
+			}
+			breakPatterns(array + left, leftSize);
+			breakPatterns(array + pivot + 1, rightSize);
+		}
+		else if (alreadyPartitioned
+			&& partialInsertionSort(array, left, pivot)
+			&& partialInsertionSort(array, pivot + 1, right))
+		{
+			// The range was (nearly) sorted already
+			return;
+		}
+
+		if (leftSize < rightSize)
+		{
+			hybridLoop(array, left, pivot, badAllowed, leftmost);
+			left = pivot + 1;
+			leftmost = false;
+		}
+		else
+		{
+			hybridLoop(array, pivot + 1, right, badAllowed, false);
+			right = pivot;
+		}
+	}
+}
+
+// Median of three, or the pseudomedian of nine for larger ranges, of [left, right)
+// moved to array[left]
+template <typename T>
+void Sorter<T>::pivotToFront(T* array, int left, int right)
+{
+	int size = right - left;
+	int middle = left + size / 2;
+	if (size > 128)
+	{
+		sort3(array, left, middle, right - 1);
+		sort3(array, left + 1, middle - 1, right - 2);
+		sort3(array, left + 2, middle + 1, right - 3);
+		sort3(array, middle - 1, middle, middle + 1);
+		std::swap(array[left], array[middle]);
+	}
+	else
+	{
+		sort3(array, middle, left, right - 1);
+	}
+}
+
+template <typename T>
+void Sorter<T>::sort3(T* array, int a, int b, int c)
+{
+	if (array[b] < array[a])
+	{
+		std::swap(array[a], array[b]);
+	}
+	if (array[c] < array[b])
+	{
+		std::swap(array[b], array[c]);
+		if (array[b] < array[a])
+		{
+			std::swap(array[a], array[b]);
+		}
+	}
+}
+
+// Partition of [left, right) around array[left]: smaller elements before it,
+// the rest after it. Returns the final pivot position; alreadyPartitioned is
+// set when no element had to be swapped (never with the vector kernel).
+template <typename T>
+int Sorter<T>::partitionRight(T* array, int left, int right, bool& alreadyPartitioned)
+{
+	T pivot = array[left];
+	if (simd)
+	{
+		alreadyPartitioned = false;
+		int split = left + SimdKernel<T>::partition(array + left + 1, right - left - 1, pivot, true);
+		std::swap(array[left], array[split]);
+		return split;
+	}
+
+	int i = left + 1;
+	int j = right - 1;
+	alreadyPartitioned = true;
+	while (true)
+	{
+		while (i <= j && array[i] < pivot)
+		{
+			i++;
+		}
+		while (i <= j && !(array[j] < pivot))
+		{
+			j--;
+		}
+		if (i > j)
+		{
+			break;
+		}
+		std::swap(array[i], array[j]);
+		alreadyPartitioned = false;
+		i++;
+		j--;
+	}
+	std::swap(array[left], array[j]);
+	return j;
+}
+
+// Partition of [left, right) around array[left] into elements not greater than it
+// (all equal to it when called from hybridLoop) and greater ones; returns the
+// position of the last element of the first group
+template <typename T>
+int Sorter<T>::partitionEqual(T* array, int left, int right)
+{
+	T pivot = array[left];
+	if (simd)
+	{
+		int split = left + SimdKernel<T>::partition(array + left + 1, right - left - 1, pivot, false);
+		std::swap(array[left], array[split]);
+		return split;
+	}
+
+	int i = left + 1;
+	int j = right - 1;
+	while (true)
+	{
+		while (i <= j && !(pivot < array[i]))
+		{
+			i++;
+		}
+		while (i <= j && pivot < array[j])
+		{
+			j--;
+		}
+		if (i > j)
+		{
+			break;
+		}
+		std::swap(array[i], array[j]);
+		i++;
+		j--;
+	}
+	std::swap(array[left], array[j]);
+	return j;
+}
+
+// Insertion sort of [left, right) that gives up after a few moved elements
+template <typename T>
+bool Sorter<T>::partialInsertionSort(T* array, int left, int right)
+{
+	const int limit = 8;
+	int moved = 0;
+	for (int i = left + 1; i < right; i++)
+	{
+		if (!(array[i] < array[i - 1]))
+		{
+			continue;
+		}
+		T value = array[i];
+		int j = i - 1;
+		while (j >= left && value < array[j])
+		{
+			array[j + 1] = array[j];
+			j--;
+		}
+		array[j + 1] = value;
+		moved += i - j - 1;
+		if (moved > limit)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename T>
+void Sorter<T>::smallSort(T* array, int size)
+{
+	if (simd && size <= SMALL_SORT_SIZE)
+	{
+		SimdKernel<T>::sortNetwork(array, size);
+	}
+	else
+	{
+		insertionSort(array, 0, size - 1);
+	}
+}
+
+template <typename T>
+int Sorter<T>::choosePivot(T* array, int left, int right, PivotStrategy pivot)
+{
+	switch (pivot)
+	{
+	case PivotStrategy::Left:
+		return left;
+	case PivotStrategy::Right:
+		return right;
+	case PivotStrategy::Middle:
+		return left + (right - left) / 2;
+	case PivotStrategy::Random:
+		return std::uniform_int_distribution<int>(left, right)(generator);
+	case PivotStrategy::MedianOfThree:
+	{
+		int middle = left + (right - left) / 2;
+		const T& a = array[left];
+		const T& b = array[middle];
+		const T& c = array[right];
+		if (a < b)
+		{
+			return b < c ? middle : (a < c ? right : left);
+		}
+		return a < c ? left : (b < c ? right : middle);
+	}
+	}
+	return left;
+}
+
+// Hoare partition around the chosen pivot; returns split such that
+// [left, split] <= pivot <= [split + 1, right], with left <= split < right
+template <typename T>
+int Sorter<T>::partition(T* array, int left, int right, PivotStrategy pivot)
+{
+	// The pivot is moved to the front, which keeps both parts non-empty
+	std::swap(array[left], array[choosePivot(array, left, right, pivot)]);
+	T value = array[left];
+
+	int i = left - 1;
+	int j = right + 1;
+	while (true)
+	{
+		do { i++; } while (array[i] < value);
+		do { j--; } while (value < array[j]);
+		if (i >= j)
+		{
+			return j;
+		}
+		std::swap(array[i], array[j]);
+	}
+}
+
+template <typename T>
+T* Sorter<T>::reserveScratch(int size)
+{
+	if ((int)scratch.size() < size)
+	{
+		scratch.resize(size);
+	}
+	return scratch.data();
+}
+
+template <typename T>
+void Sorter<T>::radixSort(T* array, int size, int digitBits)
+{
+	typedef typename ElementTraits<T>::Key Key;
+	const int passes = ((int)sizeof(Key) * 8 + digitBits - 1) / digitBits;
+	const int buckets = 1 << digitBits;
+	const Key mask = (Key)(buckets - 1);
+
+	if (size < 2)
+	{
+		return;
+	}
+
+	// Histograms of every digit are gathered in a single pass over the data
+	counts.assign((size_t)passes * buckets, 0);
+	for (int i = 0; i < size; i++)
+	{
+		Key key = ElementTraits<T>::key(array[i]);
+		for (int p = 0; p < passes; p++)
+		{
+			counts[p * buckets + (int)((key >> (p * digitBits)) & mask)]++;
+		}
+	}
+
+	// Each pass scatters between the array and the scratch buffer
+	T* from = array;
+	T* to = reserveScratch(size);
+	for (int p = 0; p < passes; p++)
+	{
+		int* count = counts.data() + p * buckets;
+		int shift = p * digitBits;
+
+		// All elements share this digit, the pass would only copy them
+		if (count[(ElementTraits<T>::key(from[0]) >> shift) & mask] == size)
+		{
+			continue;
+		}
+
+		int offset = 0;
+		for (int b = 0; b < buckets; b++)
+		{
+			int c = count[b];
+			count[b] = offset;
+			offset += c;
+		}
+		for (int i = 0; i < size; i++)
+		{
+			to[count[(ElementTraits<T>::key(from[i]) >> shift) & mask]++] = from[i];
+		}
+		std::swap(from, to);
+	}
+
+	if (from != array)
+	{
+		std::copy(from, from + size, array);
+	}
+}
+
+template <typename T>
+void Sorter<T>::countingSort(T* array, int size)
+{
+	typedef typename ElementTraits<T>::Key Key;
+
+	if (size < 2)
+	{
+		return;
+	}
+
+	Key low = ElementTraits<T>::key(array[0]);
+	Key high = low;
+	for (int i = 1; i < size; i++)
+	{
+		Key key = ElementTraits<T>::key(array[i]);
+		low = std::min(low, key);
+		high = std::max(high, key);
+	}
+	if (high - low >= (Key)COUNTING_RANGE_LIMIT)
+	{
+		radixSort(array, size, 8);
+		return;
+	}
+
+	int range = (int)(high - low) + 1;
+	counts.assign(range, 0);
+	for (int i = 0; i < size; i++)
+	{
+		counts[(int)(ElementTraits<T>::key(array[i]) - low)]++;
+	}
+	int offset = 0;
+	for (int k = 0; k < range; k++)
+	{
+		int c = counts[k];
+		counts[k] = offset;
+		offset += c;
+	}
+
+	// Scattering whole elements keeps it stable, so records keep their values
+	T* output = reserveScratch(size);
+	for (int i = 0; i < size; i++)
+	{
+		output[counts[(int)(ElementTraits<T>::key(array[i]) - low)]++] = array[i];
+	}
+	std::copy(output, output + size, array);
+}
+
+template <typename T>
+void Sorter<T>::nthElement(T* array, int size, int k)
+{
+	if (k < 0 || k >= size)
+	{
+		return;
+	}
+	int badAllowed = 1;
+	for (int n = size; n > 1; n /= 2)
+	{
+		badAllowed++;
+	}
+
+	// Same partitioning as hybridLoop, but only the part holding k is followed.
+	// While left > 0, array[left - 1] is not greater than anything in [left, right).
+	int left = 0;
+	int right = size;
+	while (right - left > SMALL_SORT_SIZE)
+	{
+		int length = right - left;
+		pivotToFront(array, left, right);
+
+		// The predecessor equals the pivot: its copies go to the front, and
+		// if k falls among them the selection is complete
+		if (left > 0 && !(array[left - 1] < array[left]))
+		{
+			int last = partitionEqual(array, left, right);
+			if (k <= last)
+			{
+				return;
+			}
+			left = last + 1;
+			continue;
+		}
+
+		bool alreadyPartitioned;
+		int pivot = partitionRight(array, left, right, alreadyPartitioned);
+		if (pivot == k)
+		{
+			return;
+		}
+		int leftSize = pivot - left;
+		int rightSize = right - pivot - 1;
+		if (leftSize < length / 8 || rightSize < length / 8)
+		{
+			if (--badAllowed == 0)
+			{
+				heapSelect(array, left, right, k);
+				return;
+			}
+			breakPatterns(array + left, leftSize);
+			breakPatterns(array + pivot + 1, rightSize);
+		}
+
+		if (k < pivot)
+		{
+			right = pivot;
+		}
+		else
+		{
+			left = pivot + 1;
+		}
+	}
+	smallSort(array + left, right - left);
+}
+
+// Puts the element of rank k (left <= k < right) at array[k] in O(n log n):
+// a max-heap of the k - left + 1 smallest elements is kept in front of the range
+template <typename T>
+void Sorter<T>::heapSelect(T* array, int left, int right, int k)
+{
+	T* heap = array + left;
+	int count = k - left + 1;
+	for (int i = count / 2 - 1; i >= 0; i--)
+	{
+		siftDown(heap, i, count);
+	}
+	for (int i = k + 1; i < right; i++)
+	{
+		if (array[i] < heap[0])
+		{
+			std::swap(array[i], heap[0]);
+			siftDown(heap, 0, count);
+		}
+	}
+	std::swap(heap[0], array[k]);
+}
+
+template <typename T>
+void Sorter<T>::partialSort(T* array, int size, int k)
+{
+	if (k <= 0)
+	{
+		return;
+	}
+	if (k >= size)
+	{
+		hybridSort(array, size);
+		return;
+	}
+	nthElement(array, size, k - 1);
+	hybridSort(array, k - 1);
+}
+
+template <typename T>
+int Sorter<T>::topK(const T* array, int size, int k, T* output)
+{
+	TopK<T> selector(k);
+	selector.push(array, size);
+	return selector.write(output);
+}
+
+template <typename T>
+bool Sorter<T>::isSorted(const T* array, int size)
+{
+	for (int i = 1; i < size; i++)
+	{
+		if (array[i] < array[i - 1])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+template class Sorter<int>;
+template class Sorter<long long>;
+template class Sorter<float>;
+template class Sorter<double>;
+template class Sorter<Record>;
@@ -0,0 +1,96 @@
+#pragma once
+#include <random>
+#include <vector>
+#include "SimdSort.h"
+
+// Gap sequences available for Shell sort
+enum class GapSequence
+{
+	Shell,		// n/2, n/4, ..., 1
+	Knuth,		// 1, 4, 13, 40, ... (3h + 1)
+	Sedgewick,	// 1, 8, 23, 77, 281, ... (4^k + 3*2^(k-1) + 1)
+	Ciura		// 1, 4, 10, 23, 57, 132, 301, 701, then *2.25
+};
+
+// Pivot choice for quicksort
+enum class PivotStrategy
+{
+	Left,
+	Right,
+	Middle,
+	Random,
+	MedianOfThree
+};
+
+// Sorting engine working in place on a plain array (e.g. Fileloader::array).
+// Element type only needs operator<; instantiated for int, long long, float,
+// double and Record (see ElementTypes.h).
+// For int and float quicksort uses the AVX2 kernels of SimdSort.h when the
+// CPU has them (SIMD partition and sorting networks for small partitions);
+// setSimd(false) forces the scalar path.
+template <typename T>
+class Sorter
+{
+public:
+	Sorter() : generator(std::random_device{}()), simd(SimdKernel<T>::supported && simdAvailable()) {}
+
+	void setSimd(bool enabled) { simd = enabled && SimdKernel<T>::supported && simdAvailable(); }
+	bool simdEnabled() const { return simd; }
+
+	void insertionSort(T* array, int size);
+	void heapSort(T* array, int size);
+	void shellSort(T* array, int size, GapSequence gaps);
+	void quickSort(T* array, int size, PivotStrategy pivot);
+	// Adaptive hybrid: arrays made of few ascending or descending runs are
+	// merged, everything else goes through a pattern-defeating introsort
+	// (ninther pivots, duplicate grouping, heapsort after too many bad splits)
+	void hybridSort(T* array, int size);
+	// Base case of quicksort and merge sort: sorting network for up to
+	// SMALL_SORT_SIZE elements when SIMD is enabled, insertion sort otherwise
+	void smallSort(T* array, int size);
+	// LSD radix sort on ElementTraits<T>::key, digitBits is 8 or 11
+	void radixSort(T* array, int size, int digitBits);
+	// Stable counting sort for keys spanning less than COUNTING_RANGE_LIMIT values,
+	// wider ranges are handed over to radixSort
+	void countingSort(T* array, int size);
+
+	// Selection, expected linear time (introselect): the element that would be
+	// at index k after sorting is put there, smaller or equal ones before it and
+	// greater or equal ones after it. Falls back to heap selection after too
+	// many unbalanced partitions. Does nothing unless 0 <= k < size.
+	void nthElement(T* array, int size, int k);
+	// The k smallest elements in ascending order at the front, the rest in
+	// unspecified order (selection, then hybridSort of the prefix)
+	void partialSort(T* array, int size, int k);
+	// Writes the k smallest elements in ascending order to output without
+	// modifying the array (bounded heap, see TopK.h); returns how many were written
+	int topK(const T* array, int size, int k, T* output);
+
+	static const int COUNTING_RANGE_LIMIT = 1 << 20;
+	static const int SMALL_SORT_SIZE = 32;
+	static const int MIN_AVERAGE_RUN = 32;	// hybridSort merges runs only when they are this long on average
+
+	static bool isSorted(const T* array, int size);
+
+private:
+	std::mt19937 generator;	// used by PivotStrategy::Random
+	bool simd;
+	std::vector<T> scratch;	// output buffer of radix and counting sort, kept between calls
+	std::vector<int> counts;	// their histograms
+
+	void insertionSort(T* array, int left, int right);
+	void siftDown(T* array, int root, int size);
+	int fillGaps(int* gaps, int size, GapSequence sequence);
+	int choosePivot(T* array, int left, int right, PivotStrategy pivot);
+	int partition(T* array, int left, int right, PivotStrategy pivot);
+	T* reserveScratch(int size);
+	void breakPatterns(T* array, int size);
+	bool mergeRuns(T* array, int size);
+	void hybridLoop(T* array, int left, int right, int badAllowed, bool leftmost);
+	void pivotToFront(T* array, int left, int right);
+	void sort3(T* array, int a, int b, int c);
+	int partitionRight(T* array, int left, int right, bool& alreadyPartitioned);
+	int partitionEqual(T* array, int left, int right);
+	bool partialInsertionSort(T* array, int left, int right);
+	void heapSelect(T* array, int left, int right, int k);
+};
@@ -0,0 +1,411 @@
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "AutoTest.h"
+#include "ElementTypes.h"
+#include "ExternalSorter.h"
+#include "Fileloader.h"
+#include "ParallelSorter.h"
+#include "Sorter.h"
+#include "Timer.h"
+
+// Returns the value following "name" among the optional trailing arguments
+std::string stringOption(int argc, char* argv[], int first, const std::string& name, const std::string& fallback) {
+    for (int i = first; i + 1 < argc; i++) {
+        if (name == argv[i]) {
+            return argv[i + 1];
+        }
+    }
+    return fallback;
+}
+
+int intOption(int argc, char* argv[], int first, const std::string& name, int fallback) {
+    std::string value = stringOption(argc, argv, first, name, "");
+    return value.empty() ? fallback : std::stoi(value);
+}
+
+// Comma separated list of integers, e.g. "1,2,4,8"
+std::vector<int> intListOption(int argc, char* argv[], int first, const std::string& name) {
+    std::string value = stringOption(argc, argv, first, name, "");
+    std::vector<int> list;
+    size_t start = 0;
+    while (start < value.size()) {
+        size_t end = value.find(',', start);
+        if (end == std::string::npos) {
+            end = value.size();
+        }
+        if (end > start) {
+            list.push_back(std::stoi(value.substr(start, end - start)));
+        }
+        start = end + 1;
+    }
+    return list;
+}
+
+// Loads, sorts, verifies and optionally saves one file of elements of type T
+template <typename T>
+int runFile(int algorithm, int variant, int threads, const std::string& inputFile, const std::string& outputFile) {
+    Fileloader<T> loader;
+    if (loader.LoadFile(inputFile) != 0) {
+        return 1;
+    }
+    std::cout << "Loaded " << loader.size << " elements of type " << ElementTraits<T>::name() << "\n";
+
+    Sorter<T> sorter;
+    // The pool is started before timing, so only the sort itself is measured
+    ParallelSorter<T>* parallel = (algorithm == 6 || algorithm == 7) ? new ParallelSorter<T>(threads) : nullptr;
+    Timer timer;
+    timer.reset();
+    timer.start();
+    switch (algorithm) {
+    case 0: sorter.insertionSort(loader.array, loader.size); break;
+    case 1: sorter.heapSort(loader.array, loader.size); break;
+    case 2: sorter.shellSort(loader.array, loader.size, static_cast<GapSequence>(variant)); break;
+    case 3: sorter.quickSort(loader.array, loader.size, static_cast<PivotStrategy>(variant)); break;
+    case 4: sorter.radixSort(loader.array, loader.size, variant == 0 ? 8 : 11); break;
+    case 5: sorter.countingSort(loader.array, loader.size); break;
+    case 6: parallel->quickSort(loader.array, loader.size); break;
+    case 7: parallel->mergeSort(loader.array, loader.size); break;
+    case 8: sorter.hybridSort(loader.array, loader.size); break;
+    }
+    timer.stop();
+
+    if (parallel != nullptr) {
+        std::cout << "Threads: " << parallel->getThreads() << "\n";
+        delete parallel;
+    }
+
+    std::cout << "Time elapsed: " << timer.result() << " ms\n";
+    if (!Sorter<T>::isSorted(loader.array, loader.size)) {
+        std::cerr << "Error: Array is not sorted!\n";
+        return 1;
+    }
+    std::cout << "Sortedness verification: PASSED\n";
+
+    if (!outputFile.empty()) {
+        if (loader.SaveToFile(outputFile) != 0) {
+            return 1;
+        }
+    }
+    else if (loader.size <= 100) {
+        loader.DisplayArray();
+    }
+    return 0;
+}
+
+// Loads a file and finds its k smallest elements; only those are displayed or saved
+template <typename T>
+int runSelect(int mode, int k, const std::string& inputFile, const std::string& outputFile) {
+    Fileloader<T> loader;
+    if (loader.LoadFile(inputFile) != 0) {
+        return 1;
+    }
+    std::cout << "Loaded " << loader.size << " elements of type " << ElementTraits<T>::name() << "\n";
+    if (k > loader.size) {
+        std::cerr << "Error: k is larger than the array (" << loader.size << " elements).\n";
+        return 1;
+    }
+
+    Sorter<T> sorter;
+    std::vector<T> output(mode == 2 ? k : 0);
+    Timer timer;
+    timer.reset();
+    timer.start();
+    switch (mode) {
+    case 0: sorter.nthElement(loader.array, loader.size, k - 1); break;
+    case 1: sorter.partialSort(loader.array, loader.size, k); break;
+    case 2: sorter.topK(loader.array, loader.size, k, output.data()); break;
+    }
+    timer.stop();
+    std::cout << "Time elapsed: " << timer.result() << " ms\n";
+
+    // The selected elements go to the front, and the loader keeps only them
+    if (mode == 2) {
+        std::copy(output.begin(), output.end(), loader.array);
+    }
+    loader.size = k;
+    std::cout << "Element of rank " << k << ": " << loader.array[k - 1] << "\n";
+
+    if (!outputFile.empty()) {
+        if (loader.SaveToFile(outputFile) != 0) {
+            return 1;
+        }
+    }
+    else if (k <= 100) {
+        loader.DisplayArray();
+    }
+    return 0;
+}
+
+// Sorts a file larger than memory through run files, then reports the phases
+template <typename T>
+int runExternal(const std::string& inputFile, const std::string& outputFile, int memoryMb, const std::string& tempDirectory) {
+    ExternalSorter<T> sorter((size_t)memoryMb << 20, tempDirectory);
+    if (sorter.sortFile(inputFile, outputFile) != 0) {
+        return 1;
+    }
+    std::cout << "Elements: " << sorter.getElements() << " (" << ElementTraits<T>::name() << ")\n"
+        << "Memory budget: " << memoryMb << " MB\n"
+        << "Sorted runs: " << sorter.getRuns() << ", merge passes: " << sorter.getMergePasses() << "\n"
+        << "Run formation: " << sorter.getRunTimeMs() << " ms\n"
+        << "Merge: " << sorter.getMergeTimeMs() << " ms\n"
+        << "Time elapsed: " << sorter.getRunTimeMs() + sorter.getMergeTimeMs() << " ms\n";
+    return 0;
+}
+
+// Runs the benchmark on generated arrays of type T, returns the number of failed runs
+template <typename T>
+int runTest(int size, int trials, unsigned seed, const std::string& algorithms, int distribution,
+    const std::vector<int>& threads, int arrays, int k, std::ostream& csv) {
+    AutoTest<T> test(size, trials, seed);
+    if (!algorithms.empty()) {
+        test.selectAlgorithms(algorithms);
+    }
+    if (distribution >= 0) {
+        test.selectDistribution(static_cast<Distribution>(distribution));
+    }
+    if (!threads.empty()) {
+        test.selectThreads(threads);
+    }
+    test.selectArrays(arrays);
+    if (k > 0) {
+        test.selectK(k);
+    }
+    return test.run(csv);
+}
+
+void showHelp() {
+    std::cout << "FILE TEST MODE:\n"
+        << "    Usage:\n"
+        << "        ./SortingAlgos --file <algorithm> <variant> <inputFile> [outputFile]\n"
+        << "    <algorithm> Sorting algorithm\n"
+        << "        0 - insertion sort, 1 - heap sort, 2 - Shell sort, 3 - quicksort,\n"
+        << "        4 - LSD radix sort, 5 - counting sort (radix sort for wide key ranges),\n"
+        << "        6 - parallel quicksort, 7 - parallel merge sort, 8 - adaptive hybrid sort\n"
+        << "    <variant> Algorithm variant (ignored by insertion, heap, counting, parallel and\n"
+        << "        hybrid sorts)\n"
+        << "        For Shell sort gaps: 0 - Shell (n/2^k), 1 - Knuth, 2 - Sedgewick, 3 - Ciura\n"
+        << "        For quicksort pivot: 0 - left, 1 - right, 2 - middle, 3 - random,\n"
+        << "            4 - median of three\n"
+        << "        For radix sort digit width: 0 - 8 bits, 1 - 11 bits\n"
+        << "    <inputFile> Input file: element count followed by the elements.\n"
+        << "    [outputFile] If provided, sorted array will be stored there. A name ending\n"
+        << "        in .bin stores the raw binary array, which loads much faster; input files\n"
+        << "        in that format are recognized automatically.\n"
+        << "    Options:\n"
+        << "    --type <t> Element type: int, int64, float, double or record\n"
+        << "        (record = \"key value\" pair sorted by key, default: int).\n"
+        << "    --threads <n> Threads of the parallel sorts (default: hardware concurrency).\n\n"
+        << "SELECTION MODE:\n"
+        << "    Usage:\n"
+        << "        ./SortingAlgos --select <mode> <k> <inputFile> [outputFile]\n"
+        << "    Finds the k smallest elements of a file in the --file format without\n"
+        << "    sorting all of it.\n"
+        << "    <mode> 0 - nth element (introselect, the k smallest in any order),\n"
+        << "        1 - partial sort (the k smallest in ascending order),\n"
+        << "        2 - top-k with a bounded heap (ascending, the array is not modified)\n"
+        << "    [outputFile] If provided, the k selected elements are stored there.\n"
+        << "    Options:\n"
+        << "    --type <t> Element type, as in file mode (default: int).\n\n"
+        << "EXTERNAL SORT MODE:\n"
+        << "    Usage:\n"
+        << "        ./SortingAlgos --external <inputFile> <outputFile> [options]\n"
+        << "    Sorts a file that does not have to fit in memory, in the --file format.\n"
+        << "    Options:\n"
+        << "    --memory <MB> Memory budget for sorted runs and merge buffers (default: 256).\n"
+        << "    --temp <dir> Directory of the temporary run files (default: next to the output).\n"
+        << "    --type <t> Element type, as in file mode (default: int).\n\n"
+        << "BENCHMARK MODE:\n"
+        << "    Usage:\n"
+        << "        ./SortingAlgos --test <size> <trials> <outputFile> [options]\n"
+        << "    <size> Number of elements in every generated array.\n"
+        << "    <trials> How many fresh arrays of each distribution are sorted.\n"
+        << "    <outputFile> CSV file with one row per run:\n"
+        << "        algorithm,type,distribution,size,arrays,threads,trial,time_ns,sorted\n"
+        << "    Options:\n"
+        << "    --algorithms <names> Comma separated name fragments, e.g. quick,shell_knuth\n"
+        << "        (default: all).\n"
+        << "    --distribution <d> Only one distribution: 0 - random, 1 - ascending,\n"
+        << "        2 - descending, 3 - 33% presorted, 4 - 66% presorted, 5 - few unique,\n"
+        << "        6 - 16 sorted runs, every other one descending\n"
+        << "        (default: all).\n"
+        << "    --seed <n> Seed of the generator (default: 1).\n"
+        << "    --type <t> Element type, as in file mode (default: int).\n"
+        << "    --threads <list> Comma separated thread counts of the parallel sorts, e.g. 1,8,32,64\n"
+        << "        (default: powers of two up to the hardware concurrency). Speedup and\n"
+        << "        efficiency are reported against a single thread.\n"
+        << "    --arrays <n> Every run sorts n separate arrays of <size> elements (default: 1),\n"
+        << "        e.g. --test 32 5 small.csv --arrays 100000 --algorithms small_sort,insertion\n"
+        << "    --k <n> Elements found by nth_element, partial_sort and top_k (default: 1% of\n"
+        << "        <size>). These are compared with full_sort (hybrid sort of the same arrays);\n"
+        << "        their sorted column tells whether the right elements were selected.\n"
+        << "    For int and float, quicksort uses AVX2 partitioning and sorting networks when\n"
+        << "    the CPU supports them; quick_median3_scalar and small_sort show the difference.\n\n"
+        << "HELP MODE:\n"
+        << "    Usage:\n"
+        << "        ./SortingAlgos --help\n"
+        << "    Displays this help message.\n"
+        << "    Notes:\n"
+        << "    - The help message will also appear if no arguments are provided.\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::string(argv[1]) == "--help") {
+        showHelp();
+        return 0;
+    }
+
+    std::string mode = argv[1];
+
+    ElementType type = ElementType::Int;
+    std::string typeName = stringOption(argc, argv, 2, "--type", "int");
+    if (!parseElementType(typeName, type)) {
+        std::cerr << "Error: Invalid type: " << typeName << ". Use int, int64, float, double or record.\n";
+        return 1;
+    }
+
+    // FILE TEST MODE
+    if (mode == "--file") {
+        if (argc < 5) {
+            std::cerr << "Error: Insufficient arguments for --file mode.\n";
+            showHelp();
+            return 1;
+        }
+
+        int algorithm = std::stoi(argv[2]);
+        int variant = std::stoi(argv[3]);
+        std::string inputFile = argv[4];
+        std::string outputFile = (argc >= 6 && std::string(argv[5]).rfind("--", 0) != 0) ? argv[5] : "";
+        int threads = intOption(argc, argv, 5, "--threads", 0);
+
+        if (algorithm < 0 || algorithm > 8) {
+            std::cerr << "Error: Invalid algorithm. Use 0 - 8.\n";
+            return 1;
+        }
+        if ((algorithm == 2 && (variant < 0 || variant > 3)) || (algorithm == 3 && (variant < 0 || variant > 4))
+            || (algorithm == 4 && (variant < 0 || variant > 1))) {
+            std::cerr << "Error: Invalid variant for the chosen algorithm.\n";
+            return 1;
+        }
+
+        switch (type) {
+        case ElementType::Int: return runFile<int>(algorithm, variant, threads, inputFile, outputFile);
+        case ElementType::Int64: return runFile<long long>(algorithm, variant, threads, inputFile, outputFile);
+        case ElementType::Float: return runFile<float>(algorithm, variant, threads, inputFile, outputFile);
+        case ElementType::Double: return runFile<double>(algorithm, variant, threads, inputFile, outputFile);
+        case ElementType::Record: return runFile<Record>(algorithm, variant, threads, inputFile, outputFile);
+        }
+    }
+    // SELECTION MODE
+    else if (mode == "--select") {
+        if (argc < 5) {
+            std::cerr << "Error: Insufficient arguments for --select mode.\n";
+            showHelp();
+            return 1;
+        }
+
+        int selectMode = std::stoi(argv[2]);
+        int k = std::stoi(argv[3]);
+        std::string inputFile = argv[4];
+        std::string outputFile = (argc >= 6 && std::string(argv[5]).rfind("--", 0) != 0) ? argv[5] : "";
+
+        if (selectMode < 0 || selectMode > 2) {
+            std::cerr << "Error: Invalid selection mode. Use 0 - 2.\n";
+            return 1;
+        }
+        if (k < 1) {
+            std::cerr << "Error: k must be positive.\n";
+            return 1;
+        }
+
+        switch (type) {
+        case ElementType::Int: return runSelect<int>(selectMode, k, inputFile, outputFile);
+        case ElementType::Int64: return runSelect<long long>(selectMode, k, inputFile, outputFile);
+        case ElementType::Float: return runSelect<float>(selectMode, k, inputFile, outputFile);
+        case ElementType::Double: return runSelect<double>(selectMode, k, inputFile, outputFile);
+        case ElementType::Record: return runSelect<Record>(selectMode, k, inputFile, outputFile);
+        }
+    }
+    // EXTERNAL SORT MODE
+    else if (mode == "--external") {
+        if (argc < 4) {
+            std::cerr << "Error: Insufficient arguments for --external mode.\n";
+            showHelp();
+            return 1;
+        }
+
+        std::string inputFile = argv[2];
+        std::string outputFile = argv[3];
+        int memoryMb = intOption(argc, argv, 4, "--memory", 256);
+        std::string tempDirectory = stringOption(argc, argv, 4, "--temp", "");
+        if (memoryMb < 1) {
+            std::cerr << "Error: Memory budget must be positive.\n";
+            return 1;
+        }
+
+        switch (type) {
+        case ElementType::Int: return runExternal<int>(inputFile, outputFile, memoryMb, tempDirectory);
+        case ElementType::Int64: return runExternal<long long>(inputFile, outputFile, memoryMb, tempDirectory);
+        case ElementType::Float: return runExternal<float>(inputFile, outputFile, memoryMb, tempDirectory);
+        case ElementType::Double: return runExternal<double>(inputFile, outputFile, memoryMb, tempDirectory);
+        case ElementType::Record: return runExternal<Record>(inputFile, outputFile, memoryMb, tempDirectory);
+        }
+    }
+    // BENCHMARK MODE
+    else if (mode == "--test") {
+        if (argc < 5) {
+            std::cerr << "Error: Insufficient arguments for --test mode.\n";
+            showHelp();
+            return 1;
+        }
+
+        int size = std::stoi(argv[2]);
+        int trials = std::stoi(argv[3]);
+        std::string outputFile = argv[4];
+        std::string algorithms = stringOption(argc, argv, 5, "--algorithms", "");
+        int distribution = intOption(argc, argv, 5, "--distribution", -1);
+        unsigned seed = (unsigned)intOption(argc, argv, 5, "--seed", 1);
+        std::vector<int> threads = intListOption(argc, argv, 5, "--threads");
+        int arrays = intOption(argc, argv, 5, "--arrays", 1);
+        int k = intOption(argc, argv, 5, "--k", 0);
+
+        if (size < 1 || trials < 1 || arrays < 1) {
+            std::cerr << "Error: Size, trials and arrays must be positive.\n";
+            return 1;
+        }
+        if (distribution > 6) {
+            std::cerr << "Error: Invalid distribution. Use 0 - 6.\n";
+            return 1;
+        }
+
+        std::ofstream csv(outputFile);
+        if (!csv.is_open()) {
+            std::cerr << "Error: Failed to open output file: " << outputFile << "\n";
+            return 1;
+        }
+
+        int failures = 0;
+        switch (type) {
+        case ElementType::Int: failures = runTest<int>(size, trials, seed, algorithms, distribution, threads, arrays, k, csv); break;
+        case ElementType::Int64: failures = runTest<long long>(size, trials, seed, algorithms, distribution, threads, arrays, k, csv); break;
+        case ElementType::Float: failures = runTest<float>(size, trials, seed, algorithms, distribution, threads, arrays, k, csv); break;
+        case ElementType::Double: failures = runTest<double>(size, trials, seed, algorithms, distribution, threads, arrays, k, csv); break;
+        case ElementType::Record: failures = runTest<Record>(size, trials, seed, algorithms, distribution, threads, arrays, k, csv); break;
+        }
+        csv.close();
+        std::cout << "\nBenchmark complete. Results saved to: " << outputFile << "\n";
+        if (failures > 0) {
+            std::cerr << "Error: " << failures << " runs left the array unsorted.\n";
+            return 1;
+        }
+    }
+    else {
+        std::cerr << "Error: Invalid mode. Use --file, --select, --external, --test or --help.\n";
+        showHelp();
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include "TextIO.h"
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	// "00", "01", ..., "99", two digits are written at once
+	struct DigitPairs
+	{
+		char text[200];
+
+		DigitPairs()
+		{
+			for (int i = 0; i < 100; i++)
+			{
+				text[2 * i] = (char)('0' + i / 10);
+				text[2 * i + 1] = (char)('0' + i % 10);
+			}
+		}
+	};
+
+	const DigitPairs digitPairs;
+
+	// Writes the decimal form of value ending just before end, returns its first character
+	char* formatUnsigned(unsigned long long value, char* end)
+	{
+		while (value >= 100)
+		{
+			end -= 2;
+			std::memcpy(end, digitPairs.text + 2 * (value % 100), 2);
+			value /= 100;
+		}
+		if (value >= 10)
+		{
+			end -= 2;
+			std::memcpy(end, digitPairs.text + 2 * value, 2);
+		}
+		else
+		{
+			*--end = (char)('0' + value);
+		}
+		return end;
+	}
+
+	bool isSpace(char c)
+	{
+		return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+	}
+}
+
+bool TextReader::skipSpace()
+{
+	while (position < end && isSpace(*position))
+	{
+		position++;
+	}
+	return position < end;
+}
+
+bool TextReader::readInteger(long long& value)
+{
+	if (!skipSpace())
+	{
+		return false;
+	}
+	bool negative = false;
+	if (*position == '-' || *position == '+')
+	{
+		negative = *position == '-';
+		position++;
+	}
+
+	// Largest magnitude that still fits, -LLONG_MIN for negative values
+	const unsigned long long limit = (unsigned long long)std::numeric_limits<long long>::max() + (negative ? 1 : 0);
+	const char* digits = position;
+	unsigned long long magnitude = 0;
+	while (position < end && (unsigned)(*position - '0') < 10)
+	{
+		unsigned digit = (unsigned)(*position - '0');
+		if (magnitude > (limit - digit) / 10)
+		{
+			return false;
+		}
+		magnitude = magnitude * 10 + digit;
+		position++;
+	}
+	if (position == digits || (position < end && !isSpace(*position)))
+	{
+		return false;
+	}
+	value = negative ? (long long)(0 - magnitude) : (long long)magnitude;
+	return true;
+}
+
+bool TextReader::read(int& value)
+{
+	long long wide;
+	if (!readInteger(wide) || wide < std::numeric_limits<int>::min() || wide > std::numeric_limits<int>::max())
+	{
+		return false;
+	}
+	value = (int)wide;
+	return true;
+}
+
+bool TextReader::read(long long& value)
+{
+	return readInteger(value);
+}
+
+bool TextReader::read(float& value)
+{
+	if (!skipSpace())
+	{
+		return false;
+	}
+	// from_chars does not accept a leading plus
+	if (*position == '+')
+	{
+		position++;
+	}
+	std::from_chars_result result = std::from_chars(position, end, value);
+	if (result.ec != std::errc())
+	{
+		return false;
+	}
+	position = result.ptr;
+	return true;
+}
+
+bool TextReader::read(double& value)
+{
+	if (!skipSpace())
+	{
+		return false;
+	}
+	if (*position == '+')
+	{
+		position++;
+	}
+	std::from_chars_result result = std::from_chars(position, end, value);
+	if (result.ec != std::errc())
+	{
+		return false;
+	}
+	position = result.ptr;
+	return true;
+}
+
+bool TextReader::read(Record& value)
+{
+	return readInteger(value.key) && readInteger(value.value);
+}
+
+TextWriter::TextWriter(std::ostream& out, size_t capacity)
+	: out(out), buffer(capacity < 64 ? 64 : capacity), used(0), written(0)
+{
+}
+
+char* TextWriter::reserve(size_t count)
+{
+	if (used + count > buffer.size())
+	{
+		flush();
+	}
+	return buffer.data() + used;
+}
+
+void TextWriter::flush()
+{
+	if (used > 0)
+	{
+		out.write(buffer.data(), (std::streamsize)used);
+		written += (long long)used;
+		used = 0;
+	}
+}
+
+void TextWriter::write(int value)
+{
+	write((long long)value);
+}
+
+void TextWriter::write(long long value)
+{
+	char text[24];
+	char* end = text + sizeof(text);
+	unsigned long long magnitude = value < 0 ? 0 - (unsigned long long)value : (unsigned long long)value;
+	char* begin = formatUnsigned(magnitude, end);
+	if (value < 0)
+	{
+		*--begin = '-';
+	}
+	size_t length = (size_t)(end - begin);
+	std::memcpy(reserve(length), begin, length);
+	used += length;
+}
+
+void TextWriter::write(float value)
+{
+	char* target = reserve(32);
+	std::to_chars_result result = std::to_chars(target, target + 32, value);
+	used += (size_t)(result.ptr - target);
+}
+
+void TextWriter::write(double value)
+{
+	char* target = reserve(32);
+	std::to_chars_result result = std::to_chars(target, target + 32, value);
+	used += (size_t)(result.ptr - target);
+}
+
+void TextWriter::write(const Record& value)
+{
+	write(value.key);
+	put(' ');
+	write(value.value);
+}
+
+void TextWriter::put(char c)
+{
+	*reserve(1) = c;
+	used++;
+}
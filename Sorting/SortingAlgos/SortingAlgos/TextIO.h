@@ -0,0 +1,61 @@
+#pragma once
+#include <ostream>
+#include <vector>
+#include "ElementTypes.h"
+
+// Parser of whitespace separated values straight from a memory buffer
+// (e.g. a MappedFile). Integers are parsed by hand, floating point values
+// with std::from_chars; records are two integers.
+class TextReader
+{
+public:
+	TextReader(const char* begin, const char* end) : position(begin), end(end) {}
+
+	// Each read skips leading whitespace; false on a malformed value or end of input
+	bool read(int& value);
+	bool read(long long& value);
+	bool read(float& value);
+	bool read(double& value);
+	bool read(Record& value);
+
+	const char* current() const { return position; }
+
+private:
+	const char* position;
+	const char* end;
+
+	bool skipSpace();
+	bool readInteger(long long& value);
+};
+
+// Buffered text output with hand-rolled integer formatting and shortest
+// round-trip floating point formatting (std::to_chars). The buffer is
+// handed to the stream in large blocks, never flushed per value.
+class TextWriter
+{
+public:
+	TextWriter(std::ostream& out, size_t capacity = 1 << 20);
+	~TextWriter() { flush(); }
+
+	TextWriter(const TextWriter&) = delete;
+	TextWriter& operator=(const TextWriter&) = delete;
+
+	void write(int value);
+	void write(long long value);
+	void write(float value);
+	void write(double value);
+	void write(const Record& value);
+	void put(char c);
+
+	void flush();
+	long long bytesWritten() const { return written + (long long)used; }
+
+private:
+	std::ostream& out;
+	std::vector<char> buffer;
+	size_t used;
+	long long written;
+
+	// Makes room for at least count more characters
+	char* reserve(size_t count);
+};
@@ -0,0 +1,124 @@
+#include "ThreadPool.h"
+
+namespace
+{
+	// Pool and index of the current thread, set once for every worker
+	thread_local const ThreadPool* current_pool = nullptr;
+	thread_local int current_index = 0;
+}
+
+ThreadPool::ThreadPool(int threads)
+{
+	thread_count = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+	if (thread_count < 1)
+	{
+		thread_count = 1;
+	}
+
+	queues = new Queue[thread_count];
+	for (int i = 1; i < thread_count; i++)
+	{
+		workers.emplace_back(&ThreadPool::workerLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(sleep_lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+	delete[] queues;
+}
+
+int ThreadPool::currentIndex() const
+{
+	return current_pool == this ? current_index : 0;
+}
+
+void ThreadPool::submit(TaskGroup& group, std::function<void()> task)
+{
+	group.pending++;
+	Queue& queue = queues[currentIndex()];
+	{
+		std::lock_guard<std::mutex> guard(queue.lock);
+		queue.tasks.push_back(Task{ &group, std::move(task) });
+	}
+	queued++;
+
+	// Taking the lock orders this with a worker that is about to fall asleep
+	{
+		std::lock_guard<std::mutex> guard(sleep_lock);
+	}
+	wake.notify_one();
+}
+
+void ThreadPool::wait(TaskGroup& group)
+{
+	int self = currentIndex();
+	while (group.pending > 0)
+	{
+		if (!runOne(self))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+// Runs the newest own task or steals the oldest one of another thread
+bool ThreadPool::runOne(int self)
+{
+	Task task;
+	bool found = false;
+	{
+		Queue& own = queues[self];
+		std::lock_guard<std::mutex> guard(own.lock);
+		if (!own.tasks.empty())
+		{
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			found = true;
+		}
+	}
+	for (int k = 1; !found && k < thread_count; k++)
+	{
+		Queue& victim = queues[(self + k) % thread_count];
+		std::lock_guard<std::mutex> guard(victim.lock);
+		if (!victim.tasks.empty())
+		{
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			found = true;
+		}
+	}
+	if (!found)
+	{
+		return false;
+	}
+
+	queued--;
+	task.run();
+	task.group->pending--;
+	return true;
+}
+
+void ThreadPool::workerLoop(int self)
+{
+	current_pool = this;
+	current_index = self;
+
+	while (!stopping)
+	{
+		if (runOne(self))
+		{
+			continue;
+		}
+		std::unique_lock<std::mutex> guard(sleep_lock);
+		wake.wait(guard, [this] { return stopping || queued > 0; });
+	}
+}
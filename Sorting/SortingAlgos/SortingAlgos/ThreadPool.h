@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join pool with work stealing. Every thread owns a deque: it pushes and
+// pops its own tasks at the back, idle threads steal the oldest (largest)
+// tasks from the front of the other deques. A thread waiting for a group
+// keeps running queued tasks, so nested fork-join never blocks the pool.
+// The thread that created the pool takes part as index 0.
+class ThreadPool
+{
+public:
+	// Counts the unfinished tasks submitted under it
+	struct TaskGroup
+	{
+		std::atomic<int> pending{ 0 };
+	};
+
+	// threads includes the calling thread, 0 means hardware concurrency
+	ThreadPool(int threads = 0);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void submit(TaskGroup& group, std::function<void()> task);
+	// Runs queued tasks until every task of the group has finished
+	void wait(TaskGroup& group);
+
+	int getThreads() const { return thread_count; }
+	// Index of the calling thread in [0, threads), threads outside the pool get 0
+	int currentIndex() const;
+
+private:
+	struct Task
+	{
+		TaskGroup* group;
+		std::function<void()> run;
+	};
+
+	struct Queue
+	{
+		std::mutex lock;
+		std::deque<Task> tasks;
+	};
+
+	int thread_count;
+	Queue* queues;
+	std::vector<std::thread> workers;
+	std::atomic<int> queued{ 0 };
+	std::atomic<bool> stopping{ false };
+	std::mutex sleep_lock;
+	std::condition_variable wake;
+
+	bool runOne(int self);
+	void workerLoop(int self);
+};
@@ -31,3 +31,10 @@ int Timer::result() {
     }
     return -1; // Timer is still running
 }
+
+long long Timer::resultNs() {
+    if (!running) {
+        return static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+    }
+    return -1; // Timer is still running
+}
@@ -8,6 +8,7 @@ public:
 	int start();
 	int stop();
 	int result();
+	long long resultNs();
 
 private:
 	std::chrono::high_resolution_clock::time_point start_time;
@@ -0,0 +1,113 @@
+#include "TopK.h"
+#include <algorithm>
+#include "ElementTypes.h"
+
+template <typename T>
+TopK<T>::TopK(int k) : limit(std::max(k, 0))
+{
+	heap.reserve(limit);
+}
+
+template <typename T>
+void TopK<T>::push(const T& value)
+{
+	if ((int)heap.size() < limit)
+	{
+		heap.push_back(value);
+		siftUp((int)heap.size() - 1);
+	}
+	else if (limit > 0 && value < heap[0])
+	{
+		// The largest kept value drops out
+		heap[0] = value;
+		siftDown(0);
+	}
+}
+
+template <typename T>
+void TopK<T>::push(const T* values, int count)
+{
+	int i = 0;
+	while (i < count && (int)heap.size() < limit)
+	{
+		push(values[i++]);
+	}
+	if (limit == 0)
+	{
+		return;
+	}
+	// Most values of a long stream are rejected here without touching the heap
+	for (; i < count; i++)
+	{
+		if (values[i] < heap[0])
+		{
+			heap[0] = values[i];
+			siftDown(0);
+		}
+	}
+}
+
+template <typename T>
+int TopK<T>::write(T* output) const
+{
+	std::copy(heap.begin(), heap.end(), output);
+	std::sort(output, output + heap.size());
+	return (int)heap.size();
+}
+
+template <typename T>
+std::vector<T> TopK<T>::sorted() const
+{
+	std::vector<T> values(heap.size());
+	write(values.data());
+	return values;
+}
+
+template <typename T>
+void TopK<T>::siftUp(int index)
+{
+	T value = heap[index];
+	while (index > 0)
+	{
+		int parent = (index - 1) / 2;
+		if (!(heap[parent] < value))
+		{
+			break;
+		}
+		heap[index] = heap[parent];
+		index = parent;
+	}
+	heap[index] = value;
+}
+
+template <typename T>
+void TopK<T>::siftDown(int index)
+{
+	int count = (int)heap.size();
+	T value = heap[index];
+	while (true)
+	{
+		int child = 2 * index + 1;
+		if (child >= count)
+		{
+			break;
+		}
+		if (child + 1 < count && heap[child] < heap[child + 1])
+		{
+			child++;
+		}
+		if (!(value < heap[child]))
+		{
+			break;
+		}
+		heap[index] = heap[child];
+		index = child;
+	}
+	heap[index] = value;
+}
+
+template class TopK<int>;
+template class TopK<long long>;
+template class TopK<float>;
+template class TopK<double>;
+template class TopK<Record>;
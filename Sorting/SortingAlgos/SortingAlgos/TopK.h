@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+
+// Streaming selector of the k smallest values: a max-heap bounded to k
+// elements whose root is the largest value kept so far. Values are pushed
+// one at a time or in blocks (e.g. Fileloader::array, or chunks of a stream
+// that does not fit in memory), so memory stays O(k) and a value that cannot
+// make it costs a single comparison with the root.
+// Instantiated for int, long long, float, double and Record.
+template <typename T>
+class TopK
+{
+public:
+	explicit TopK(int k);
+
+	void push(const T& value);
+	void push(const T* values, int count);
+
+	int capacity() const { return limit; }
+	int size() const { return (int)heap.size(); }
+	// Largest value kept so far; only valid when size() > 0
+	const T& threshold() const { return heap[0]; }
+
+	// Copies the kept values in ascending order to output, returns their count.
+	// The selector is left unchanged and can keep consuming values.
+	int write(T* output) const;
+	std::vector<T> sorted() const;
+	void clear() { heap.clear(); }
+
+private:
+	int limit;
+	std::vector<T> heap;
+
+	void siftUp(int index);
+	void siftDown(int index);
+};